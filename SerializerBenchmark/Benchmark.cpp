@@ -0,0 +1,2004 @@
+/******************************************************************************/
+/*!
+\file       Benchmark.cpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Benchmark
+{
+    // *********************************************************
+    // *Allocation counters, both operator new and rapidjson's allocators go through these
+    // *********************************************************
+    struct AllocationStats
+    {
+        size_t count = 0;
+        size_t bytes = 0;
+    };
+
+    inline std::atomic<size_t> g_AllocationCount{ 0 };
+    inline std::atomic<size_t> g_AllocatedBytes{ 0 };
+
+    inline void* CountedMalloc(size_t size)
+    {
+        g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+        g_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size);
+    }
+
+    inline void* CountedRealloc(void* pointer, size_t size)
+    {
+        g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+        g_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        return std::realloc(pointer, size);
+    }
+
+    inline AllocationStats GetAllocationStats()
+    {
+        return { g_AllocationCount.load(std::memory_order_relaxed), g_AllocatedBytes.load(std::memory_order_relaxed) };
+    }
+}
+
+#define RAPIDJSON_MALLOC(size) Benchmark::CountedMalloc(size)
+#define RAPIDJSON_REALLOC(pointer, newSize) Benchmark::CountedRealloc(pointer, newSize)
+
+#include "BinarySerialization.hpp"
+#include "JsonPatch.hpp"
+#include "LazyLoad.hpp"
+#include "Logger.h"
+#include "MemberListSerializer.hpp"
+#include "ObjectGraph.hpp"
+#include "PartialLoad.hpp"
+
+void* operator new(size_t size)
+{
+    if (void* pointer = Benchmark::CountedMalloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+using namespace Reflect;
+
+namespace Benchmark
+{
+    // Synthetic scene, every circle goes through the same RTTR walk as a real save
+    struct scene
+    {
+        std::vector<circle> circles;
+    };
+
+    // 60 reflected properties, the size of our big engine components
+#define BENCHMARK_COMPONENT_FIELDS(FIELD) \
+    FIELD(float, field00) FIELD(int, field01) FIELD(float, field02) FIELD(int, field03) FIELD(float, field04) FIELD(int, field05) \
+    FIELD(float, field06) FIELD(int, field07) FIELD(float, field08) FIELD(int, field09) FIELD(float, field10) FIELD(int, field11) \
+    FIELD(float, field12) FIELD(int, field13) FIELD(float, field14) FIELD(int, field15) FIELD(float, field16) FIELD(int, field17) \
+    FIELD(float, field18) FIELD(int, field19) FIELD(float, field20) FIELD(int, field21) FIELD(float, field22) FIELD(int, field23) \
+    FIELD(float, field24) FIELD(int, field25) FIELD(float, field26) FIELD(int, field27) FIELD(float, field28) FIELD(int, field29) \
+    FIELD(float, field30) FIELD(int, field31) FIELD(float, field32) FIELD(int, field33) FIELD(float, field34) FIELD(int, field35) \
+    FIELD(float, field36) FIELD(int, field37) FIELD(float, field38) FIELD(int, field39) FIELD(float, field40) FIELD(int, field41) \
+    FIELD(float, field42) FIELD(int, field43) FIELD(float, field44) FIELD(int, field45) FIELD(float, field46) FIELD(int, field47) \
+    FIELD(float, field48) FIELD(int, field49) FIELD(float, field50) FIELD(int, field51) FIELD(float, field52) FIELD(int, field53) \
+    FIELD(float, field54) FIELD(int, field55) FIELD(float, field56) FIELD(int, field57) FIELD(float, field58) FIELD(int, field59)
+
+    struct component
+    {
+#define FIELD(Type, Name) Type Name = 0;
+        BENCHMARK_COMPONENT_FIELDS(FIELD)
+#undef FIELD
+    };
+
+    // Small hot type, twice with the same fields, only listedBody has a member list
+    // Both go through the same walker, so the difference is the generated functions vs the RTTR properties
+#define BENCHMARK_BODY_FIELDS(FIELD) \
+    FIELD(float, px) FIELD(float, py) FIELD(float, pz) FIELD(float, vx) FIELD(float, vy) FIELD(float, vz) FIELD(float, mass) FIELD(int, id)
+
+    struct body
+    {
+#define FIELD(Type, Name) Type Name = 0;
+        BENCHMARK_BODY_FIELDS(FIELD)
+#undef FIELD
+    };
+
+    struct listedBody
+    {
+#define FIELD(Type, Name) Type Name = 0;
+        BENCHMARK_BODY_FIELDS(FIELD)
+#undef FIELD
+    };
+
+    template <typename Body>
+    struct bodyList
+    {
+        std::vector<Body> bodies;
+    };
+
+    // Materials shared by many entities, fallback goes round all the materials in a cycle
+    struct material
+    {
+        std::string name;
+        std::vector<float> parameters;
+        material* fallback = nullptr;
+    };
+
+    struct entity
+    {
+        std::string name;
+        std::shared_ptr<material> surface;
+    };
+
+    struct world
+    {
+        std::vector<entity> entities;
+    };
+
+    // What has to be saved without references, a copy of the material in every entity and no fallback
+    struct materialCopy
+    {
+        std::string name;
+        std::vector<float> parameters;
+    };
+
+    struct inlineEntity
+    {
+        std::string name;
+        materialCopy surface;
+    };
+
+    struct inlineWorld
+    {
+        std::vector<inlineEntity> entities;
+    };
+}
+
+template <>
+struct JSON::MemberList<Benchmark::listedBody>
+{
+    static constexpr auto members = std::make_tuple(
+        JSON::MakeMember("px", &Benchmark::listedBody::px),
+        JSON::MakeMember("py", &Benchmark::listedBody::py),
+        JSON::MakeMember("pz", &Benchmark::listedBody::pz),
+        JSON::MakeMember("vx", &Benchmark::listedBody::vx),
+        JSON::MakeMember("vy", &Benchmark::listedBody::vy),
+        JSON::MakeMember("vz", &Benchmark::listedBody::vz),
+        JSON::MakeMember("mass", &Benchmark::listedBody::mass),
+        JSON::MakeMember("id", &Benchmark::listedBody::id));
+};
+
+namespace Benchmark
+{
+
+    scene MakeScene(size_t circleCount)
+    {
+        scene syntheticScene;
+        syntheticScene.circles.reserve(circleCount);
+
+        for (size_t i = 0; i < circleCount; ++i)
+        {
+            const int index = static_cast<int>(i);
+
+            circle c{ "Circle #" + std::to_string(i) };
+            c.position = point2d{ index, index * 2 };
+            c.dictionary = { {color::green, {index, 1} }, {color::blue, {index, 2} }, {color::red, {index, 3} } };
+            c.radius = 1.0 + static_cast<double>(i) * 0.25;
+            c.points = { {index, 1}, {index, 2}, {index, 3}, {index, 4} };
+            c.clown = { 1, 2, 3, 4, 5, 6, 7, 8, index };
+            c.allah = Vector3{ 1.5f * index, 2.5f, 3.5f };
+            syntheticScene.circles.push_back(std::move(c));
+        }
+        return syntheticScene;
+    }
+
+    // Every behaviour check of the Compare* functions reports through this, main returns non zero if any of them failed
+    inline size_t g_FailedCheckCount = 0;
+
+    inline void ReportFailedCheck(const char* format, ...)
+    {
+        ++g_FailedCheckCount;
+        va_list arguments;
+        va_start(arguments, format);
+        std::vprintf(format, arguments);
+        va_end(arguments);
+    }
+
+    // Runs function iterations times and returns the average time in milliseconds
+    template <typename Function>
+    double MeasureMilliseconds(Function&& function, int iterations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            function();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    // Same as MeasureMilliseconds, but also returns the average allocations per iteration
+    template <typename Function>
+    double MeasureMilliseconds(Function&& function, int iterations, AllocationStats& allocations)
+    {
+        const AllocationStats before = GetAllocationStats();
+        const double milliseconds = MeasureMilliseconds(std::forward<Function>(function), iterations);
+        const AllocationStats after = GetAllocationStats();
+
+        allocations.count = (after.count - before.count) / iterations;
+        allocations.bytes = (after.bytes - before.bytes) / iterations;
+        return milliseconds;
+    }
+
+    // DeserializeFromFile before the in situ load path
+    // ifstream -> stringstream -> str() for the empty check -> str() again for Document::Parse, which copies every string again
+    void LegacyDeserializeFromFile(const std::filesystem::path& filePath, rttr::instance rttrObject)
+    {
+        std::ifstream file{ filePath };
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+
+        rapidjson::Document document;
+        if (buffer.str().empty() || document.Parse(buffer.str().c_str()).HasParseError())
+        {
+            return;
+        }
+
+        JSON::Reader ownReader{ document };
+        ownReader.ReadFromJsonRecursively(rttrObject, ownReader.GetValueData());
+    }
+
+    // Old stringstream load path vs reading once into an owned buffer + ParseInsitu vs streaming through SaxReader
+    void CompareLoadPaths(const scene& syntheticScene, int iterations)
+    {
+        const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "SerializerBenchmark_load.json";
+        JSON::SerializeToFile(filePath, syntheticScene);
+        const uintmax_t fileSize = std::filesystem::file_size(filePath);
+
+        std::printf("\n[Load] %zu circles, %ju bytes on disk, %d iterations\n", syntheticScene.circles.size(), fileSize, iterations);
+        std::printf("%-12s %12s %14s %16s\n", "Path", "Read(ms)", "Allocations", "Allocated(MB)");
+
+        AllocationStats legacyAllocations;
+        const double legacyTime = MeasureMilliseconds([&]()
+            {
+                scene loadedScene;
+                LegacyDeserializeFromFile(filePath, loadedScene);
+            }, iterations, legacyAllocations);
+
+        AllocationStats insituAllocations;
+        const double insituTime = MeasureMilliseconds([&]()
+            {
+                scene loadedScene;
+                JSON::DeserializeFromFile(filePath, loadedScene);
+            }, iterations, insituAllocations);
+
+        // No Document and no file sized buffer, what is left is the objects themselves
+        AllocationStats saxAllocations;
+        const double saxTime = MeasureMilliseconds([&]()
+            {
+                scene loadedScene;
+                JSON::DeserializeFromFileSax(filePath, loadedScene);
+            }, iterations, saxAllocations);
+
+        std::printf("%-12s %12.3f %14zu %16.3f\n", "Stringstream", legacyTime, legacyAllocations.count, legacyAllocations.bytes / (1024.0 * 1024.0));
+        std::printf("%-12s %12.3f %14zu %16.3f\n", "Insitu", insituTime, insituAllocations.count, insituAllocations.bytes / (1024.0 * 1024.0));
+        std::printf("%-12s %12.3f %14zu %16.3f\n", "Sax", saxTime, saxAllocations.count, saxAllocations.bytes / (1024.0 * 1024.0));
+
+        // Both readers have to load the same scene
+        scene insituScene;
+        scene saxScene;
+        JSON::DeserializeFromFile(filePath, insituScene);
+        JSON::DeserializeFromFileSax(filePath, saxScene);
+        if (JSON::ToJsonFormat(insituScene, JSON::JsonFormat::Compact) != JSON::ToJsonFormat(saxScene, JSON::JsonFormat::Compact))
+        {
+            ReportFailedCheck("Sax load does not match the Document load!\n");
+        }
+
+        std::filesystem::remove(filePath);
+    }
+
+    // ReadFromJsonRecursively before the single pass, FindMember (linear scan) for every reflected property
+    void LegacyReadFromJsonRecursively(JSON::Reader& reader, rttr::instance object, rapidjson::Value& jsonObject)
+    {
+        const JSON::TypePlan& plan = JSON::GetTypePlan(object.get_derived_type());
+        for (const JSON::PropertyPlan& propertyPlan : plan.properties)
+        {
+            rapidjson::Value::MemberIterator member = jsonObject.FindMember(propertyPlan.name.c_str());
+            if (member != jsonObject.MemberEnd())
+            {
+                reader.ReadProperty(object, propertyPlan, member->value);
+            }
+        }
+    }
+
+    // Member matching on a 60 property type, FindMember per property vs one pass through the perfect hash
+    void CompareMemberMatching(size_t componentCount, int iterations)
+    {
+        std::vector<component> components(componentCount);
+        for (size_t i = 0; i < componentCount; ++i)
+        {
+            components[i].field00 = static_cast<float>(i);
+            components[i].field59 = static_cast<int>(i);
+        }
+
+        // Top level array of components
+        std::string json = "[";
+        for (size_t i = 0; i < componentCount; ++i)
+        {
+            json += (i == 0 ? "" : ",") + JSON::ToJsonFormat(components[i], JSON::JsonFormat::Compact);
+        }
+        json += "]";
+
+        rapidjson::Document document;
+        document.Parse(json.c_str(), json.size());
+
+        const size_t propertyCount = rttr::type::get<component>().get_properties().size();
+        std::printf("\n[Member matching] %zu components, %zu properties each, %d iterations\n", componentCount, propertyCount, iterations);
+        std::printf("%-12s %12s %14s\n", "Matching", "Read(ms)", "ns/property");
+
+        JSON::Reader reader{ document };
+        component target;
+
+        const double legacyTime = MeasureMilliseconds([&]()
+            {
+                for (rapidjson::Value& element : document.GetArray())
+                {
+                    LegacyReadFromJsonRecursively(reader, target, element);
+                }
+            }, iterations);
+
+        const double singlePassTime = MeasureMilliseconds([&]()
+            {
+                for (rapidjson::Value& element : document.GetArray())
+                {
+                    reader.ReadFromJsonRecursively(target, element);
+                }
+            }, iterations);
+
+        const double properties = static_cast<double>(componentCount * propertyCount);
+        std::printf("%-12s %12.3f %14.2f\n", "FindMember", legacyTime, legacyTime * 1e6 / properties);
+        std::printf("%-12s %12.3f %14.2f\n", "SinglePass", singlePassTime, singlePassTime * 1e6 / properties);
+    }
+
+    // Compact JSON vs the binary format on the same scene, and a JSON <-> binary round trip
+    void CompareBinaryFormat(const scene& syntheticScene, int iterations)
+    {
+        std::printf("\n[Binary] %zu circles, %d iterations\n", syntheticScene.circles.size(), iterations);
+        std::printf("%-10s %14s %12s %12s\n", "Format", "Bytes", "Write(ms)", "Read(ms)");
+
+        std::string json;
+        const double jsonWriteTime = MeasureMilliseconds([&]()
+            {
+                json = JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Compact);
+            }, iterations);
+        const double jsonReadTime = MeasureMilliseconds([&]()
+            {
+                scene loadedScene;
+                std::string buffer = json;
+                JSON::FromJsonFormatSax(buffer.data(), loadedScene);
+            }, iterations);
+
+        std::string binary;
+        const double binaryWriteTime = MeasureMilliseconds([&]()
+            {
+                binary = Binary::ToBinaryFormat(syntheticScene);
+            }, iterations);
+        const double binaryReadTime = MeasureMilliseconds([&]()
+            {
+                scene loadedScene;
+                Binary::FromBinaryFormat(binary, loadedScene);
+            }, iterations);
+
+        std::printf("%-10s %14zu %12.3f %12.3f\n", "Compact", json.size(), jsonWriteTime, jsonReadTime);
+        std::printf("%-10s %14zu %12.3f %12.3f\n", "Binary", binary.size(), binaryWriteTime, binaryReadTime);
+
+        // JSON -> object -> binary -> object -> JSON has to give back the JSON it started with
+        scene fromJson;
+        JSON::FromJsonFormat(json.data(), fromJson);
+        scene fromBinary;
+        Binary::FromBinaryFormat(Binary::ToBinaryFormat(fromJson), fromBinary);
+        if (JSON::ToJsonFormat(fromBinary, JSON::JsonFormat::Compact) != JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Compact))
+        {
+            ReportFailedCheck("JSON <-> binary round trip does not match!\n");
+        }
+    }
+
+    // The same bodies through the RTTR properties and through the functions generated from a member list
+    // JSON and binary, both have to give the exact same output
+    void CompareMemberList(size_t bodyCount, int iterations)
+    {
+        bodyList<body> rttrBodies;
+        bodyList<listedBody> listedBodies;
+        for (size_t i = 0; i < bodyCount; ++i)
+        {
+            const float value = static_cast<float>(i);
+            rttrBodies.bodies.push_back(body{ value, value * 0.5f, -value, 1.25f, 2.5f, -3.75f, 10.0f + value, static_cast<int>(i) });
+            listedBodies.bodies.push_back(listedBody{ value, value * 0.5f, -value, 1.25f, 2.5f, -3.75f, 10.0f + value, static_cast<int>(i) });
+        }
+
+        if (JSON::GetTypePlan(rttr::type::get<listedBody>()).memberList == nullptr)
+        {
+            ReportFailedCheck("Member list registered after the plan was built is not used!\n");
+        }
+
+        std::printf("\n[Member list] %zu bodies, %d iterations\n", bodyCount, iterations);
+        std::printf("%-12s %14s %14s %14s %14s\n", "Path", "Write(ms)", "Read(ms)", "BinWrite(ms)", "BinRead(ms)");
+
+        std::string outputs[2][2];
+        const auto measure = [&](const char* name, auto& bodies, std::string* output)
+        {
+            using Bodies = std::decay_t<decltype(bodies)>;
+            const double writeTime = MeasureMilliseconds([&]()
+                {
+                    output[0] = JSON::ToJsonFormat(bodies, JSON::JsonFormat::Compact);
+                }, iterations);
+            const double readTime = MeasureMilliseconds([&]()
+                {
+                    Bodies loaded;
+                    std::string buffer = output[0];
+                    JSON::FromJsonFormat(buffer.data(), loaded);
+                }, iterations);
+            const double binaryWriteTime = MeasureMilliseconds([&]()
+                {
+                    output[1] = Binary::ToBinaryFormat(bodies);
+                }, iterations);
+            const double binaryReadTime = MeasureMilliseconds([&]()
+                {
+                    Bodies loaded;
+                    Binary::FromBinaryFormat(output[1], loaded);
+                }, iterations);
+            std::printf("%-12s %14.3f %14.3f %14.3f %14.3f\n", name, writeTime, readTime, binaryWriteTime, binaryReadTime);
+        };
+
+        measure("RTTR", rttrBodies, outputs[0]);
+        measure("MemberList", listedBodies, outputs[1]);
+
+        // Loaded back through the member list, then written through it again
+        bodyList<listedBody> fromJson;
+        bodyList<listedBody> fromBinary;
+        std::string buffer = outputs[1][0];
+        JSON::FromJsonFormatSax(buffer.data(), fromJson);
+        Binary::FromBinaryFormat(outputs[1][1], fromBinary);
+        if (outputs[0][0] != outputs[1][0] || outputs[0][1] != outputs[1][1] ||
+            JSON::ToJsonFormat(fromJson, JSON::JsonFormat::Compact) != outputs[0][0] || Binary::ToBinaryFormat(fromBinary) != outputs[0][1])
+        {
+            ReportFailedCheck("Member list output does not match the RTTR output!\n");
+        }
+
+        // Numbers out of the range of their member leave it as it is, through the member list like through RTTR
+        const std::string outOfRange = "{\"px\":1e300,\"mass\":2.5,\"id\":1e300}";
+        body rttrBody{};
+        rttrBody.px = 7.f;
+        rttrBody.id = 9;
+        listedBody documentBody{};
+        documentBody.px = 7.f;
+        documentBody.id = 9;
+        listedBody saxBody = documentBody;
+        buffer = outOfRange;
+        JSON::FromJsonFormat(buffer.data(), rttrBody);
+        buffer = outOfRange;
+        JSON::FromJsonFormat(buffer.data(), documentBody);
+        buffer = outOfRange;
+        JSON::FromJsonFormatSax(buffer.data(), saxBody);
+        const std::string rttrJson = JSON::ToJsonFormat(rttrBody, JSON::JsonFormat::Compact);
+        if (documentBody.px != 7.f || documentBody.id != 9 || documentBody.mass != 2.5f ||
+            JSON::ToJsonFormat(documentBody, JSON::JsonFormat::Compact) != rttrJson || JSON::ToJsonFormat(saxBody, JSON::JsonFormat::Compact) != rttrJson)
+        {
+            ReportFailedCheck("Member list load of out of range numbers does not match the RTTR load!\n");
+        }
+    }
+
+    // Full saves vs deltas against a prefab, every circle is the prefab placed somewhere else
+    void CompareDeltaSerialization(const scene& syntheticScene, int iterations)
+    {
+        const circle& prefab = syntheticScene.circles.front();
+        std::vector<circle> placed(syntheticScene.circles.size(), prefab);
+        for (size_t i = 0; i < placed.size(); ++i)
+        {
+            placed[i].position = point2d{ static_cast<int>(i), -static_cast<int>(i) };
+            placed[i].radius = prefab.radius + static_cast<double>(i % 7);
+        }
+
+        std::printf("\n[Delta] %zu circles placed from one prefab, %d iterations\n", placed.size(), iterations);
+        std::printf("%-10s %14s %12s %12s\n", "Save", "Bytes", "Write(ms)", "Read(ms)");
+
+        std::vector<std::string> full(placed.size());
+        const double fullWriteTime = MeasureMilliseconds([&]()
+            {
+                for (size_t i = 0; i < placed.size(); ++i)
+                {
+                    full[i] = JSON::ToJsonFormat(placed[i], JSON::JsonFormat::Compact);
+                }
+            }, iterations);
+
+        std::vector<std::string> deltas(placed.size());
+        const double deltaWriteTime = MeasureMilliseconds([&]()
+            {
+                for (size_t i = 0; i < placed.size(); ++i)
+                {
+                    deltas[i] = JSON::ToJsonDelta(placed[i], prefab, JSON::JsonFormat::Compact);
+                }
+            }, iterations);
+
+        std::vector<circle> loaded(placed.size());
+        const double fullReadTime = MeasureMilliseconds([&]()
+            {
+                for (size_t i = 0; i < placed.size(); ++i)
+                {
+                    std::string buffer = full[i];
+                    loaded[i] = circle{};
+                    JSON::FromJsonFormat(buffer.data(), loaded[i]);
+                }
+            }, iterations);
+
+        const double deltaReadTime = MeasureMilliseconds([&]()
+            {
+                for (size_t i = 0; i < placed.size(); ++i)
+                {
+                    std::string buffer = deltas[i];
+                    loaded[i] = prefab;
+                    JSON::FromJsonDelta(buffer.data(), loaded[i]);
+                }
+            }, iterations);
+
+        size_t fullBytes = 0;
+        size_t deltaBytes = 0;
+        for (size_t i = 0; i < placed.size(); ++i)
+        {
+            fullBytes += full[i].size();
+            deltaBytes += deltas[i].size();
+        }
+
+        std::printf("%-10s %14zu %12.3f %12.3f\n", "Full", fullBytes, fullWriteTime, fullReadTime);
+        std::printf("%-10s %14zu %12.3f %12.3f\n", "Delta", deltaBytes, deltaWriteTime, deltaReadTime);
+        std::printf("Delta is %.1fx smaller\n", static_cast<double>(fullBytes) / static_cast<double>(std::max<size_t>(1, deltaBytes)));
+
+        // Prefab + delta has to give back the placed circle
+        for (size_t i = 0; i < placed.size(); ++i)
+        {
+            if (JSON::ToJsonFormat(loaded[i], JSON::JsonFormat::Compact) != full[i])
+            {
+                ReportFailedCheck("Delta round trip does not match at circle %zu!\n", i);
+                break;
+            }
+        }
+    }
+
+    // One edited circle pushed into a loaded scene, reloading the whole scene vs a JSON Patch vs a Merge Patch of that circle
+    // Replace is a patch that can be applied over and over, its allocations show the walk does not copy the circles
+    void CompareJsonPatch(const scene& syntheticScene, int iterations)
+    {
+        const size_t edited = syntheticScene.circles.size() / 2;
+        const std::string path = "/circles/" + std::to_string(edited);
+        const std::string patch = "[{\"op\":\"replace\",\"path\":\"" + path + "/radius\",\"value\":42.5},"
+            "{\"op\":\"add\",\"path\":\"" + path + "/points/-\",\"value\":{\"x\":7,\"y\":8}},"
+            "{\"op\":\"test\",\"path\":\"" + path + "/radius\",\"value\":42.5}]";
+        const std::string mergePatch = "{\"position\":{\"x\":3},\"allah\":null}";
+
+        scene expected = syntheticScene;
+        expected.circles[edited].radius = 42.5;
+        expected.circles[edited].points.push_back(point2d{ 7, 8 });
+        const std::string json = JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Compact);
+        const std::string expectedJson = JSON::ToJsonFormat(expected, JSON::JsonFormat::Compact);
+
+        std::printf("\n[JSON Patch] %zu circles, one circle edited, %d iterations\n", syntheticScene.circles.size(), iterations);
+        std::printf("%-12s %14s %12s %12s\n", "Update", "Bytes", "Apply(ms)", "Allocations");
+
+        scene target = syntheticScene;
+        const double reloadTime = MeasureMilliseconds([&]()
+            {
+                std::string buffer = expectedJson;
+                JSON::FromJsonFormat(buffer.data(), target);
+            }, iterations);
+
+        bool isPatched = true;
+        const double patchTime = MeasureMilliseconds([&]()
+            {
+                target = syntheticScene;
+                std::string buffer = patch;
+                isPatched = JSON::ApplyPatch(target, buffer.data()) && isPatched;
+            }, iterations);
+        // Copying the scene back is part of the loop above, take it out again
+        const double copyTime = MeasureMilliseconds([&]()
+            {
+                target = syntheticScene;
+            }, iterations);
+
+        const std::string replacePatch = "[{\"op\":\"replace\",\"path\":\"" + path + "/radius\",\"value\":42.5}]";
+        AllocationStats replaceAllocations;
+        const double replaceTime = MeasureMilliseconds([&]()
+            {
+                std::string buffer = replacePatch;
+                isPatched = JSON::ApplyPatch(target, buffer.data()) && isPatched;
+            }, iterations, replaceAllocations);
+        isPatched = isPatched && target.circles[edited].radius == 42.5;
+
+        circle mergeTarget = syntheticScene.circles[edited];
+        const double mergeTime = MeasureMilliseconds([&]()
+            {
+                std::string buffer = mergePatch;
+                isPatched = JSON::ApplyMergePatch(mergeTarget, buffer.data()) && isPatched;
+            }, iterations);
+
+        std::printf("%-12s %14zu %12.3f %12s\n", "Reload", expectedJson.size(), reloadTime, "");
+        std::printf("%-12s %14zu %12.3f %12s\n", "Patch", patch.size(), std::max(0.0, patchTime - copyTime), "");
+        std::printf("%-12s %14zu %12.3f %12zu\n", "Replace", replacePatch.size(), replaceTime, replaceAllocations.count);
+        std::printf("%-12s %14zu %12.3f %12s\n", "MergePatch", mergePatch.size(), mergeTime, "");
+
+        target = syntheticScene;
+        std::string buffer = patch;
+        JSON::ApplyPatch(target, buffer.data());
+        if (!isPatched || JSON::ToJsonFormat(target, JSON::JsonFormat::Compact) != expectedJson ||
+            mergeTarget.position.x != 3 || mergeTarget.allah.x != Vector3{}.x || mergeTarget.allah.z != Vector3{}.z)
+        {
+            ReportFailedCheck("Patched objects do not match!\n");
+        }
+    }
+
+    // Whole scene file vs only the position of one circle out of it, near the start (parsing stops early) and at the end (everything is skipped over)
+    void ComparePartialLoad(const scene& syntheticScene, int iterations)
+    {
+        const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "SerializerBenchmark_partial.json";
+        JSON::SerializeToFile(filePath, syntheticScene, JSON::JsonFormat::Compact);
+        const size_t last = syntheticScene.circles.size() - 1;
+
+        std::printf("\n[Partial load] %zu circles, %d iterations\n", syntheticScene.circles.size(), iterations);
+        std::printf("%-22s %12s %12s\n", "Selection", "Read(ms)", "Allocations");
+
+        scene target = syntheticScene;
+        const double fullTime = MeasureMilliseconds([&]()
+            {
+                JSON::DeserializeFromFile(filePath, target);
+            }, iterations);
+        std::printf("%-22s %12.3f %12s\n", "Everything", fullTime, "");
+
+        bool isLoaded = true;
+        for (const size_t index : { size_t{ 0 }, last })
+        {
+            const std::vector<JSON::Pointer> pointers{ JSON::Pointer(("/circles/" + std::to_string(index) + "/position").c_str()) };
+            const std::string name = "circles[" + std::to_string(index) + "].position";
+
+            target.circles[index].position = point2d{ -1, -1 };
+            // scene::circles is registered with RegisterPropertyReference, the allocations do not grow with the circle count
+            AllocationStats partialAllocations;
+            const double partialTime = MeasureMilliseconds([&]()
+                {
+                    isLoaded = JSON::DeserializeFromFilePartial(filePath, target, pointers) && isLoaded;
+                }, iterations, partialAllocations);
+            std::printf("%-22s %12.3f %12zu\n", name.c_str(), partialTime, partialAllocations.count);
+
+            const point2d& position = target.circles[index].position;
+            isLoaded = isLoaded && position.x == syntheticScene.circles[index].position.x && position.y == syntheticScene.circles[index].position.y;
+        }
+
+        if (!isLoaded)
+        {
+            ReportFailedCheck("Partial load did not load the selected positions!\n");
+        }
+        std::filesystem::remove(filePath);
+    }
+
+    // Components loaded eagerly vs through a LazyHandle that only reads 2 of the 60 properties vs one that materializes everything
+    // Retained is what the handles keep alive for the properties that were not read yet
+    void CompareLazyLoad(size_t componentCount, int iterations)
+    {
+        component source;
+        source.field00 = 1.5f;
+        source.field59 = 59;
+        const std::string json = JSON::ToJsonFormat(source, JSON::JsonFormat::Compact);
+
+        std::vector<component> targets(componentCount);
+        std::vector<std::unique_ptr<JSON::LazyHandle>> handles;
+        for (component& target : targets)
+        {
+            handles.push_back(std::make_unique<JSON::LazyHandle>(target));
+        }
+
+        std::printf("\n[Lazy load] %zu components, 2 of %zu properties read, %d iterations\n", componentCount,
+            rttr::type::get<component>().get_properties().size(), iterations);
+        std::printf("%-20s %12s %14s %14s\n", "Load", "Read(ms)", "Allocations", "Retained(KB)");
+
+        std::string input;
+        AllocationStats eagerAllocations;
+        const double eagerTime = MeasureMilliseconds([&]()
+            {
+                for (component& target : targets)
+                {
+                    input = json;
+                    JSON::FromJsonFormat(input.data(), target);
+                }
+            }, iterations, eagerAllocations);
+        std::printf("%-20s %12.3f %14zu %14.1f\n", "FromJsonFormat", eagerTime, eagerAllocations.count, 0.0);
+
+        bool isLoaded = true;
+        const auto retainedKilobytes = [&]()
+        {
+            size_t retained = 0;
+            for (const std::unique_ptr<JSON::LazyHandle>& handle : handles)
+            {
+                retained += handle->GetRetainedBytes();
+            }
+            return static_cast<double>(retained) / 1024.0;
+        };
+
+        AllocationStats lazyAllocations;
+        const double lazyTime = MeasureMilliseconds([&]()
+            {
+                for (std::unique_ptr<JSON::LazyHandle>& handle : handles)
+                {
+                    handle->Load(json.data(), json.size());
+                    isLoaded = handle->GetValue<float>("field00") == source.field00 && handle->GetValue<int>("field59") == source.field59 && isLoaded;
+                }
+            }, iterations, lazyAllocations);
+        std::printf("%-20s %12.3f %14zu %14.1f\n", "LazyHandle(2 read)", lazyTime, lazyAllocations.count, retainedKilobytes());
+
+        AllocationStats allAllocations;
+        const double allTime = MeasureMilliseconds([&]()
+            {
+                for (std::unique_ptr<JSON::LazyHandle>& handle : handles)
+                {
+                    handle->Load(json.data(), json.size());
+                    handle->MaterializeAll();
+                }
+            }, iterations, allAllocations);
+        std::printf("%-20s %12.3f %14zu %14.1f\n", "LazyHandle(all)", allTime, allAllocations.count, retainedKilobytes());
+
+        if (!isLoaded || JSON::ToJsonFormat(targets.back(), JSON::JsonFormat::Compact) != json)
+        {
+            ReportFailedCheck("Lazy load does not match the eager load!\n");
+        }
+    }
+
+    // Entities sharing a few materials, saved with a copy of the material per entity vs as an object graph with every material once
+    // The loaded graph has to hold the same number of materials, with the fallback cycle pointing at them again
+    void CompareObjectGraph(size_t entityCount, int iterations)
+    {
+        const size_t materialCount = entityCount / 100 + 1;
+        std::vector<std::shared_ptr<material>> materials;
+        for (size_t i = 0; i < materialCount; ++i)
+        {
+            materials.push_back(std::make_shared<material>(material{ "Material #" + std::to_string(i), std::vector<float>(16, static_cast<float>(i)) }));
+        }
+        for (size_t i = 0; i < materialCount; ++i)
+        {
+            materials[i]->fallback = materials[(i + 1) % materialCount].get();
+        }
+
+        world graphWorld;
+        inlineWorld copyWorld;
+        for (size_t i = 0; i < entityCount; ++i)
+        {
+            const std::shared_ptr<material>& surface = materials[i % materialCount];
+            graphWorld.entities.push_back(entity{ "Entity #" + std::to_string(i), surface });
+            copyWorld.entities.push_back(inlineEntity{ "Entity #" + std::to_string(i), materialCopy{ surface->name, surface->parameters } });
+        }
+
+        std::printf("\n[Object graph] %zu entities sharing %zu materials, %d iterations\n", entityCount, materialCount, iterations);
+        std::printf("%-12s %12s %12s %12s\n", "Format", "Size(KB)", "Write(ms)", "Read(ms)");
+
+        std::string copyJson;
+        const double copyWriteTime = MeasureMilliseconds([&]()
+            {
+                copyJson = JSON::ToJsonFormat(copyWorld, JSON::JsonFormat::Compact);
+            }, iterations);
+        const double copyReadTime = MeasureMilliseconds([&]()
+            {
+                inlineWorld loaded;
+                std::string buffer = copyJson;
+                JSON::FromJsonFormat(buffer.data(), loaded);
+            }, iterations);
+        std::printf("%-12s %12.1f %12.3f %12.3f\n", "Inline", static_cast<double>(copyJson.size()) / 1024.0, copyWriteTime, copyReadTime);
+
+        std::string graphJson;
+        const double graphWriteTime = MeasureMilliseconds([&]()
+            {
+                graphJson = JSON::ToJsonGraph(graphWorld, JSON::JsonFormat::Compact);
+            }, iterations);
+        const double graphReadTime = MeasureMilliseconds([&]()
+            {
+                world loaded;
+                std::vector<std::shared_ptr<void>> objects;
+                std::string buffer = graphJson;
+                JSON::FromJsonGraph(buffer.data(), loaded, objects);
+            }, iterations);
+        std::printf("%-12s %12.1f %12.3f %12.3f\n", "Graph", static_cast<double>(graphJson.size()) / 1024.0, graphWriteTime, graphReadTime);
+
+        world loaded;
+        std::vector<std::shared_ptr<void>> objects;
+        std::string buffer = graphJson;
+        bool isRestored = JSON::FromJsonGraph(buffer.data(), loaded, objects) && objects.size() == materialCount &&
+            loaded.entities.size() == entityCount;
+        for (size_t i = 0; i < loaded.entities.size() && isRestored; ++i)
+        {
+            isRestored = loaded.entities[i].surface == loaded.entities[i % materialCount].surface;
+        }
+        // Following the fallbacks goes through every material once and comes back
+        const material* first = isRestored ? loaded.entities.front().surface.get() : nullptr;
+        const material* current = first;
+        for (size_t i = 0; i < materialCount && current != nullptr; ++i)
+        {
+            current = current->fallback;
+        }
+        if (!isRestored || current != first || first == nullptr || JSON::ToJsonGraph(loaded, JSON::JsonFormat::Compact) != graphJson)
+        {
+            ReportFailedCheck("Object graph was not restored!\n");
+        }
+    }
+
+    // ToJsonFormatBatch on 1, 2, 4... hardware threads, every thread count has to give the exact same document
+    // Every allocation also bumps the shared counters of this benchmark, which costs some scaling that a normal build does not have
+    void CompareParallelSerialization(const scene& syntheticScene, int iterations)
+    {
+        const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        std::printf("\n[Batch] %zu circles, %u hardware threads, %d iterations\n", syntheticScene.circles.size(), hardwareThreads, iterations);
+        std::printf("%-8s %12s %10s %14s\n", "Threads", "Write(ms)", "Speedup", "ns/object");
+
+        const std::string reference = JSON::ToJsonFormatBatch(syntheticScene.circles, JSON::JsonFormat::Compact, 1);
+        double singleThreadTime = 0.0;
+
+        for (unsigned threadCount = 1; ; threadCount = std::min(threadCount * 2, hardwareThreads))
+        {
+            std::string json;
+            const double writeTime = MeasureMilliseconds([&]()
+                {
+                    json = JSON::ToJsonFormatBatch(syntheticScene.circles, JSON::JsonFormat::Compact, threadCount);
+                }, iterations);
+
+            if (threadCount == 1)
+            {
+                singleThreadTime = writeTime;
+            }
+            std::printf("%-8u %12.3f %10.2f %14.1f\n", threadCount, writeTime, singleThreadTime / writeTime,
+                writeTime * 1e6 / static_cast<double>(syntheticScene.circles.size()));
+
+            if (json != reference)
+            {
+                ReportFailedCheck("Batch output with %u threads does not match the single thread output!\n", threadCount);
+            }
+            if (threadCount == hardwareThreads)
+            {
+                break;
+            }
+        }
+
+        // Pretty blocks are spliced with their indentation, the result has to parse back into the same circles
+        const std::string pretty = JSON::ToJsonFormatBatch(syntheticScene.circles, JSON::JsonFormat::Pretty);
+        rapidjson::Document document;
+        if (document.Parse(pretty.c_str()).HasParseError() || !document.IsArray() || document.Size() != syntheticScene.circles.size())
+        {
+            ReportFailedCheck("Pretty batch output is not an array of every circle!\n");
+        }
+
+        // Elements whose last property is a sequential container, EndArray of every block follows a single line array
+        std::vector<materialCopy> materials(64);
+        for (size_t i = 0; i < materials.size(); ++i)
+        {
+            materials[i].name = "material" + std::to_string(i);
+            materials[i].parameters = { static_cast<float>(i), 0.5f, 2.f };
+        }
+        const std::string prettyMaterials = JSON::ToJsonFormatBatch(materials, JSON::JsonFormat::Pretty, 4);
+        rapidjson::Document materialDocument;
+        if (prettyMaterials != JSON::ToJsonFormatBatch(materials, JSON::JsonFormat::Pretty, 1) ||
+            materialDocument.Parse(prettyMaterials.c_str()).HasParseError() || !materialDocument.IsArray() || materialDocument.Size() != materials.size() ||
+            std::string(materialDocument[static_cast<rapidjson::SizeType>(materials.size() - 1)]["name"].GetString()) != materials.back().name)
+        {
+            ReportFailedCheck("Pretty batch output of elements ending in a vector is not valid JSON!\n");
+        }
+    }
+
+    // Cost of a log call on 1, 2, 4... threads logging at once, a mutex + formatting + write on the calling thread
+    // (the old logError with the handle kept open) vs the lock free ring of Logger::Logger
+    // Max is the slowest single call, the ring has no path that waits on another thread
+    void CompareLogger(size_t messageCount, int iterations)
+    {
+        const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::string syncPath = (directory / "SerializerBenchmark_sync.log").string();
+        const std::string asyncPath = (directory / "SerializerBenchmark_async.log").string();
+        const std::string message = "Unable to retrieve property value of circle";
+
+        std::printf("\n[Logger] %zu messages, %d iterations\n", messageCount, iterations);
+        std::printf("%-8s %-12s %12s %12s %10s\n", "Threads", "Logger", "ns/call", "Max(us)", "Dropped");
+
+        // Every thread logs its share of messageCount, returns the average and the slowest call in nanoseconds
+        const auto run = [&](unsigned threadCount, auto&& log)
+        {
+            std::vector<double> slowest(threadCount, 0.0);
+            double total = 0.0;
+            for (int iteration = 0; iteration < iterations; ++iteration)
+            {
+                std::vector<std::thread> threads;
+                const auto start = std::chrono::steady_clock::now();
+                for (unsigned thread = 0; thread < threadCount; ++thread)
+                {
+                    threads.emplace_back([&, thread]()
+                        {
+                            for (size_t i = thread; i < messageCount; i += threadCount)
+                            {
+                                const auto callStart = std::chrono::steady_clock::now();
+                                log();
+                                const std::chrono::duration<double, std::nano> call = std::chrono::steady_clock::now() - callStart;
+                                slowest[thread] = std::max(slowest[thread], call.count());
+                            }
+                        });
+                }
+                for (std::thread& thread : threads)
+                {
+                    thread.join();
+                }
+                const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+                total += elapsed.count() * threadCount;
+            }
+            return std::make_pair(total / (static_cast<double>(messageCount) * iterations), *std::max_element(slowest.begin(), slowest.end()));
+        };
+
+        for (unsigned threadCount = 1; ; threadCount = std::min(threadCount * 2, hardwareThreads))
+        {
+            std::filesystem::remove(syncPath);
+            {
+                Logger::FileWriter file{ syncPath.c_str() };
+                std::mutex mutex;
+                const auto sync = run(threadCount, [&]()
+                    {
+                        const std::string line = "[Error] " + message + " on " + Logger::Logger::logCurrentDateTime() + "\n";
+                        std::lock_guard<std::mutex> lock{ mutex };
+                        file.writeLine(line);
+                    });
+                std::printf("%-8u %-12s %12.1f %12.2f %10d\n", threadCount, "Synchronous", sync.first, sync.second / 1000.0, 0);
+            }
+
+            std::filesystem::remove(asyncPath);
+            Logger::Logger logger{ asyncPath.c_str(), 1 << 16 };
+            const auto async = run(threadCount, [&]()
+                {
+                    logger.logError(message, Logger::ErrorType::ERROR);
+                });
+            logger.flush();
+            std::printf("%-8u %-12s %12.1f %12.2f %10zu\n", threadCount, "Async", async.first, async.second / 1000.0, logger.getDroppedCount());
+
+            // Every call that was not dropped is one line in the file
+            const std::string logged = logger.getFileName().string();
+            Logger::FileWriter reader{ logged.c_str() };
+            const std::string content = reader.readFile();
+            const size_t lineCount = static_cast<size_t>(std::count(content.begin(), content.end(), '\n'));
+            if (lineCount + logger.getDroppedCount() != messageCount * static_cast<size_t>(iterations))
+            {
+                ReportFailedCheck("Async logger wrote %zu lines, %zu were logged!\n", lineCount, messageCount * iterations - logger.getDroppedCount());
+            }
+
+            if (threadCount == hardwareThreads)
+            {
+                break;
+            }
+        }
+    }
+
+    // Same load with no sink (the default) vs a DiagnosticCollector, which also keeps the JSON path while reading
+    // Then one radius that does not fit its property, which has to come back with its path and not stop the load
+    void CompareDiagnostics(const scene& syntheticScene, int iterations)
+    {
+        const std::string json = JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Compact);
+        std::string broken = json;
+        const std::string radiusKey = "\"radius\":";
+        const size_t radius = broken.find(radiusKey) + radiusKey.size();
+        broken.replace(radius, broken.find_first_of(",}", radius) - radius, "\"big\"");
+
+        std::printf("\n[Diagnostics] %zu circles, %d iterations\n", syntheticScene.circles.size(), iterations);
+        std::printf("%-12s %12s %12s\n", "Sink", "Read(ms)", "Reported");
+
+        scene target;
+        JSON::DiagnosticCollector collector;
+        for (JSON::DiagnosticSink* sink : { static_cast<JSON::DiagnosticSink*>(nullptr), static_cast<JSON::DiagnosticSink*>(&collector) })
+        {
+            JSON::SetDiagnosticSink(sink);
+            const double readTime = MeasureMilliseconds([&]()
+                {
+                    std::string buffer = json;
+                    JSON::FromJsonFormat(buffer.data(), target);
+                }, iterations);
+            std::printf("%-12s %12.3f %12zu\n", sink == nullptr ? "None" : "Collector", readTime, collector.TakeEntries().size());
+        }
+
+        std::string buffer = broken;
+        const JSON::SerializationResult result = JSON::FromJsonFormat(buffer.data(), target);
+        std::string truncated = json.substr(0, json.size() / 2);
+        const JSON::SerializationResult parseResult = JSON::FromJsonFormat(truncated.data(), target);
+        JSON::SetDiagnosticSink(nullptr);
+
+        const std::vector<JSON::DiagnosticCollector::Entry> entries = collector.TakeEntries();
+        const bool isReported = entries.size() == 2 &&
+            entries[0].code == JSON::ErrorCode::ValueMismatch && entries[0].path == "/circles/0/radius" && entries[0].property == "radius" &&
+            entries[1].code == JSON::ErrorCode::ParseError && parseResult.code == JSON::ErrorCode::ParseError && parseResult.offset > 0;
+        if (!result || !isReported || target.circles.size() != syntheticScene.circles.size())
+        {
+            ReportFailedCheck("Diagnostics did not report the broken radius and the parse error!\n");
+        }
+    }
+
+    // Save and load of the scene with the JSON_TRACE_* scopes compiled in, the slowest types and properties and the trace file
+    // Only does something when the benchmark is built with JSONTRACE defined, the scopes are ((void)0) otherwise
+    void CompareTracing(const scene& syntheticScene, int iterations)
+    {
+#ifdef JSONTRACE
+        const std::filesystem::path tracePath = std::filesystem::temp_directory_path() / "SerializerBenchmark_trace.json";
+        const std::string json = JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Compact);
+
+        std::printf("\n[Tracing] %zu circles, %d iterations\n", syntheticScene.circles.size(), iterations);
+        JSON::ResetTrace();
+        scene target;
+        const double saveTime = MeasureMilliseconds([&]()
+            {
+                JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Compact);
+            }, iterations);
+        const double loadTime = MeasureMilliseconds([&]()
+            {
+                std::string buffer = json;
+                JSON::FromJsonFormat(buffer.data(), target);
+            }, iterations);
+        std::printf("Traced save %.3f ms, load %.3f ms\n", saveTime, loadTime);
+
+        const auto print = [](const char* title, const std::vector<JSON::TraceEntry>& entries)
+        {
+            std::printf("%-8s %-36s %12s %12s %14s\n", "", title, "Count", "Time(ms)", "Bytes");
+            for (size_t i = 0; i < std::min<size_t>(entries.size(), 5); ++i)
+            {
+                const JSON::TraceEntry& entry = entries[i];
+                std::printf("%-8s %-36s %12llu %12.3f %14llu\n", JSON::GetTraceOperationName(entry.operation), entry.name.c_str(),
+                    static_cast<unsigned long long>(entry.stats.count), entry.stats.nanoseconds / 1e6, static_cast<unsigned long long>(entry.stats.bytes));
+            }
+        };
+        const std::vector<JSON::TraceEntry> typeStats = JSON::GetTraceTypeStats();
+        print("Type", typeStats);
+        print("Property", JSON::GetTracePropertyStats());
+
+        // Every byte of every save went through the scene scope, and every load read the whole input
+        const size_t runs = static_cast<size_t>(iterations);
+        bool isCounted = false;
+        for (const JSON::TraceEntry& entry : typeStats)
+        {
+            if (entry.name == rttr::type::get<scene>().get_name().to_string() && entry.operation == JSON::TraceOperation::Write)
+            {
+                isCounted = entry.stats.count == runs && entry.stats.bytes == json.size() * runs;
+            }
+        }
+        if (!isCounted || !JSON::WriteChromeTrace(tracePath))
+        {
+            ReportFailedCheck("Trace did not count the bytes of the saves or could not be written!\n");
+        }
+        std::filesystem::remove(tracePath);
+
+        // Threads started one after another take over the record of the one before, and ResetTrace frees the exited ones
+        const auto recordCount = []()
+        {
+            JSON::TraceRegistry& registry = JSON::GetTraceRegistry();
+            std::lock_guard<std::mutex> lock{ registry.mutex };
+            return registry.threads.size();
+        };
+        const size_t recordsBefore = recordCount();
+        for (int i = 0; i < 8; ++i)
+        {
+            std::thread([&]() { JSON::ToJsonFormat(syntheticScene.circles.front(), JSON::JsonFormat::Compact); }).join();
+        }
+        const size_t recordsAfter = recordCount();
+        JSON::ResetTrace();
+        if (recordsAfter > recordsBefore + 1 || recordCount() > recordsBefore)
+        {
+            ReportFailedCheck("Trace records of exited threads are not reused or freed!\n");
+        }
+#else
+        (void)syntheticScene;
+        (void)iterations;
+        std::printf("\n[Tracing] Compiled out, define JSONTRACE to record\n");
+#endif
+    }
+
+    // InvokeRegisteredClassFunction before MethodHandle, the object is copied into the call and the method looked up by name
+    template <typename Class>
+    rttr::variant LegacyInvokeRegisteredClassFunction(rttr::string_view nameOfFunction, rttr::string_view NameOfClass, Class obj, std::vector<rttr::argument> args)
+    {
+        const rttr::type classType = rttr::type::get_by_name(NameOfClass);
+        return classType.is_valid() ? classType.invoke(nameOfFunction, obj, args) : rttr::variant{};
+    }
+
+    // radiusDouble on every circle of the scene, by name (with and without the copy) vs a MethodHandle one by one vs its batch calls
+    void CompareMethodHandle(const scene& syntheticScene, int iterations)
+    {
+        std::vector<circle> circles = syntheticScene.circles;
+        const size_t count = circles.size();
+        const float factor = 2.f;
+        std::vector<rttr::variant> results(count);
+        std::vector<double> values(count, 0.0);
+
+        std::printf("\n[Method handle] %zu circles, %d iterations\n", count, iterations);
+        std::printf("%-12s %12s %12s\n", "Invoke", "Total(ms)", "ns/call");
+
+        double sums[5] = {};
+        const auto print = [&](const char* name, double milliseconds)
+        {
+            std::printf("%-12s %12.3f %12.1f\n", name, milliseconds, milliseconds * 1e6 / static_cast<double>(count));
+        };
+        const auto sum = [&]()
+        {
+            double total = 0.0;
+            for (const rttr::variant& result : results)
+            {
+                total += result.is_type<double>() ? result.get_value<double>() : 0.0;
+            }
+            return total;
+        };
+
+        print("ByNameCopy", MeasureMilliseconds([&]()
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    results[i] = LegacyInvokeRegisteredClassFunction<circle>("radiusDouble", "circle", circles[i], { factor });
+                }
+            }, iterations));
+        sums[0] = sum();
+
+        print("ByName", MeasureMilliseconds([&]()
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    results[i] = InvokeRegisteredClassFunction<circle>("radiusDouble", "circle", circles[i], { factor });
+                }
+            }, iterations));
+        sums[1] = sum();
+
+        const MethodHandle radiusDouble = MethodHandle::Find<circle>("radiusDouble", { rttr::type::get<float>() });
+        print("Handle", MeasureMilliseconds([&]()
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    results[i] = radiusDouble.Invoke(circles[i], factor);
+                }
+            }, iterations));
+        sums[2] = sum();
+
+        print("Batch", MeasureMilliseconds([&]()
+            {
+                radiusDouble.InvokeBatch(circles.data(), count, results.data(), factor);
+            }, iterations));
+        sums[3] = sum();
+
+        size_t invokedCount = 0;
+        print("BatchValues", MeasureMilliseconds([&]()
+            {
+                invokedCount = radiusDouble.InvokeBatchValues(circles.data(), count, values.data(), factor);
+            }, iterations));
+        for (const double value : values)
+        {
+            sums[4] += value;
+        }
+
+        double expected = 0.0;
+        for (const circle& item : circles)
+        {
+            expected += item.radius * factor;
+        }
+        if (!radiusDouble || invokedCount != count || sums[0] != expected || sums[1] != expected || sums[2] != expected || sums[3] != expected || sums[4] != expected)
+        {
+            ReportFailedCheck("Method handle results do not match the calls by name!\n");
+        }
+    }
+
+    // InvokeGlobalRegisteredFunction before the batch API, arguments copied in and the function looked up by name for every argument
+    std::vector<rttr::variant> LegacyInvokeGlobalRegisteredFunction(rttr::string_view nameOfFunction, std::vector<rttr::argument> args)
+    {
+        std::vector<rttr::variant> values;
+        if (rttr::type::get_global_method(nameOfFunction))
+        {
+            for (const rttr::argument& itr : args)
+            {
+                values.emplace_back(rttr::type::invoke(nameOfFunction, { itr }));
+            }
+        }
+        return values;
+    }
+
+    // The registered "sin" over valueCount floats, the old by name path vs InvokeGlobalRegisteredFunction vs MethodHandle::InvokeGlobalBatch
+    void CompareGlobalFunctionBatch(size_t valueCount, int iterations)
+    {
+        std::vector<float> inputs(valueCount);
+        std::vector<rttr::argument> arguments;
+        arguments.reserve(valueCount);
+        for (size_t i = 0; i < valueCount; ++i)
+        {
+            inputs[i] = static_cast<float>(i % 1000) * 0.001f;
+            arguments.emplace_back(inputs[i]);
+        }
+        std::vector<float> outputs(valueCount, 0.f);
+
+        std::printf("\n[Global function batch] sin over %zu values, %d iterations\n", valueCount, iterations);
+        std::printf("%-12s %12s %12s %14s\n", "Invoke", "Total(ms)", "ns/call", "Allocations");
+
+        const auto print = [&](const char* name, double milliseconds, const AllocationStats& allocations)
+        {
+            std::printf("%-12s %12.3f %12.1f %14zu\n", name, milliseconds, milliseconds * 1e6 / static_cast<double>(valueCount), allocations.count);
+        };
+
+        std::vector<rttr::variant> legacyValues;
+        AllocationStats legacyAllocations;
+        print("ByName", MeasureMilliseconds([&]()
+            {
+                legacyValues = LegacyInvokeGlobalRegisteredFunction("sin", arguments);
+            }, iterations, legacyAllocations), legacyAllocations);
+
+        std::vector<rttr::variant> values;
+        AllocationStats resolvedAllocations;
+        print("Resolved", MeasureMilliseconds([&]()
+            {
+                values = InvokeGlobalRegisteredFunction("sin", arguments);
+            }, iterations, resolvedAllocations), resolvedAllocations);
+
+        const MethodHandle sinHandle = MethodHandle::FindGlobal("sin", { rttr::type::get<float>() });
+        size_t invokedCount = 0;
+        AllocationStats batchAllocations;
+        print("Batch", MeasureMilliseconds([&]()
+            {
+                invokedCount = sinHandle.InvokeGlobalBatch(inputs.data(), valueCount, outputs.data());
+            }, iterations, batchAllocations), batchAllocations);
+
+        bool isMatching = sinHandle && invokedCount == valueCount && legacyValues.size() == valueCount && values.size() == valueCount;
+        for (size_t i = 0; isMatching && i < valueCount; ++i)
+        {
+            isMatching = legacyValues[i].is_type<float>() && values[i].is_type<float>() &&
+                legacyValues[i].get_value<float>() == outputs[i] && values[i].get_value<float>() == outputs[i] && outputs[i] == Reflect::sin(inputs[i]);
+        }
+        if (!isMatching || batchAllocations.count != 0)
+        {
+            ReportFailedCheck("Batched sin does not match the calls by name or allocated!\n");
+        }
+    }
+
+    // Top level array of circles, ReadFromJsonRecursively over every element on one thread vs FromJsonFormatBatch on 1, 2, 4... threads
+    void CompareParallelDeserialization(const scene& syntheticScene, int iterations)
+    {
+        const std::string json = JSON::ToJsonFormatBatch(syntheticScene.circles, JSON::JsonFormat::Compact);
+        const size_t circleCount = syntheticScene.circles.size();
+        const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::printf("\n[BatchRead] %zu circles, %u hardware threads, %d iterations\n", circleCount, hardwareThreads, iterations);
+        std::printf("%-10s %12s %12s %10s\n", "Threads", "Parse(ms)", "Read(ms)", "Speedup");
+
+        // Current path, the elements one after another
+        double serialReadTime = 0.0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            std::string buffer = json;
+            std::vector<circle> circles(circleCount);
+            rapidjson::Document document;
+            document.ParseInsitu(buffer.data());
+
+            const auto start = std::chrono::steady_clock::now();
+            JSON::Reader ownReader{ document };
+            for (rapidjson::SizeType index = 0; index < document.Size(); ++index)
+            {
+                ownReader.ReadFromJsonRecursively(circles[index], document[index]);
+            }
+            serialReadTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        serialReadTime /= iterations;
+        std::printf("%-10s %12s %12.3f %10.2f\n", "Serial", "-", serialReadTime, 1.0);
+
+        JSON::BatchReadReport lastReport;
+        for (unsigned threadCount = 1; ; threadCount = std::min(threadCount * 2, hardwareThreads))
+        {
+            double parseTime = 0.0;
+            double readTime = 0.0;
+            std::vector<circle> circles;
+            for (int i = 0; i < iterations; ++i)
+            {
+                std::string buffer = json;
+                circles.assign(circleCount, circle());
+                JSON::FromJsonFormatBatch(buffer.data(), circles, threadCount, &lastReport);
+                parseTime += lastReport.parseMilliseconds;
+                readTime += lastReport.readMilliseconds;
+            }
+            parseTime /= iterations;
+            readTime /= iterations;
+            std::printf("%-10u %12.3f %12.3f %10.2f\n", threadCount, parseTime, readTime, serialReadTime / readTime);
+
+            if (JSON::ToJsonFormatBatch(circles, JSON::JsonFormat::Compact) != json)
+            {
+                ReportFailedCheck("Batch load with %u threads does not match the saved circles!\n", threadCount);
+            }
+            if (threadCount == hardwareThreads)
+            {
+                break;
+            }
+        }
+
+        // How evenly the last run spread the circles over the threads
+        std::printf("%-10s %12s %12s\n", "Thread", "Objects", "Busy(ms)");
+        for (size_t i = 0; i < lastReport.threads.size(); ++i)
+        {
+            std::printf("%-10zu %12zu %12.3f\n", i, lastReport.threads[i].objects, lastReport.threads[i].milliseconds);
+        }
+    }
+
+    // Vertex buffer + transform, the contiguous fast path has to handle both
+    struct mesh
+    {
+        std::vector<float> vertices;
+        std::array<float, 16> transform{};
+    };
+
+    // Element by element through variant_sequential_view vs one tight loop over the container memory
+    void CompareContiguousContainers(size_t elementCount, int iterations)
+    {
+        std::vector<float> vertices(elementCount);
+        for (size_t i = 0; i < elementCount; ++i)
+        {
+            vertices[i] = static_cast<float>(i) * 0.5f;
+        }
+
+        const rttr::variant verticesVariant = vertices;
+        const JSON::ContiguousContainer* contiguous = JSON::FindContiguousContainer(rttr::type::get<std::vector<float>>());
+
+        std::printf("\n[Contiguous] std::vector<float> of %zu elements, %d iterations\n", elementCount, iterations);
+        std::printf("%-12s %12s %12s %16s %16s\n", "Path", "Write(ms)", "Read(ms)", "Write(Melem/s)", "Read(Melem/s)");
+
+        for (const bool useContiguous : { false, true })
+        {
+            std::string json;
+            const double writeTime = MeasureMilliseconds([&]()
+                {
+                    json.clear();
+                    char writeBuffer[JSON::WRITE_BUFFER_SIZE];
+                    JSON::OutputStream stream{ json, writeBuffer, sizeof(writeBuffer) };
+                    rapidjson::Writer<JSON::OutputStream> writer(stream);
+                    JSON::CompactWriter ownWriter{ writer };
+                    if (useContiguous)
+                    {
+                        ownWriter.WriteContiguous(*contiguous, verticesVariant);
+                    }
+                    else
+                    {
+                        ownWriter.WriteArray(verticesVariant.create_sequential_view());
+                    }
+                    stream.Flush();
+                }, iterations);
+
+            rapidjson::Document document;
+            document.Parse(json.c_str());
+            const double readTime = MeasureMilliseconds([&]()
+                {
+                    rttr::variant loaded = std::vector<float>();
+                    if (useContiguous)
+                    {
+                        JSON::Reader::ReadContiguous(*contiguous, loaded, document);
+                    }
+                    else
+                    {
+                        JSON::Reader ownReader{ document };
+                        rttr::variant_sequential_view view = loaded.create_sequential_view();
+                        ownReader.ReadArray(view, document);
+                    }
+                }, iterations);
+
+            const double elements = static_cast<double>(elementCount);
+            std::printf("%-12s %12.3f %12.3f %16.2f %16.2f\n", useContiguous ? "Contiguous" : "PerElement",
+                writeTime, readTime, elements / (writeTime * 1e3), elements / (readTime * 1e3));
+        }
+
+        // Round trip through the RTTR walk, std::vector and the registered std::array both take the fast path
+        mesh savedMesh;
+        savedMesh.vertices = vertices;
+        for (size_t i = 0; i < savedMesh.transform.size(); ++i)
+        {
+            savedMesh.transform[i] = static_cast<float>(i);
+        }
+
+        std::string json = JSON::ToJsonFormat(savedMesh, JSON::JsonFormat::Compact);
+        mesh loadedMesh;
+        JSON::FromJsonFormat(json.data(), loadedMesh);
+        if (loadedMesh.vertices != savedMesh.vertices || loadedMesh.transform != savedMesh.transform)
+        {
+            ReportFailedCheck("Contiguous round trip does not match!\n");
+        }
+    }
+
+    // Pretty vs Compact output size + write/parse time
+    void CompareJsonFormats(const scene& syntheticScene, int iterations)
+    {
+        std::printf("\n[JsonFormat] %zu circles, %d iterations\n", syntheticScene.circles.size(), iterations);
+        std::printf("%-10s %14s %12s %12s\n", "Format", "Bytes", "Write(ms)", "Read(ms)");
+
+        for (const JSON::JsonFormat format : { JSON::JsonFormat::Pretty, JSON::JsonFormat::Compact })
+        {
+            std::string json;
+            const double writeTime = MeasureMilliseconds([&]()
+                {
+                    json = JSON::ToJsonFormat(syntheticScene, format);
+                }, iterations);
+
+            const double readTime = MeasureMilliseconds([&]()
+                {
+                    scene loadedScene;
+                    std::stringstream buffer{ json };
+                    JSON::FromJsonFormat(buffer, loadedScene);
+                }, iterations);
+
+            std::printf("%-10s %14zu %12.3f %12.3f\n", format == JSON::JsonFormat::Pretty ? "Pretty" : "Compact", json.size(), writeTime, readTime);
+        }
+    }
+}
+
+namespace Benchmark
+{
+    // *********************************************************
+    // *Suite: every exposed entry point on synthetic scenes of circles (shape, point2d, Vector3, map keyed by color)
+    // *Reports ns/object, MB/s and allocations per run and writes the same numbers to a JSON results file
+    // *********************************************************
+    struct SuiteResult
+    {
+        std::string operation;
+        size_t objects = 0;
+        // Bytes written or read by one run
+        size_t bytes = 0;
+        int runs = 0;
+        double nanosecondsPerObject = 0.0;
+        double megabytesPerSecond = 0.0;
+        AllocationStats allocationsPerRun;
+    };
+
+    // Many small level files loaded one after another, a fresh Document/buffer per load vs one DeserializationContext for all of them
+    // Components only have arithmetic properties, so what is left with the context is what RTTR allocates itself
+    void CompareDeserializationContext(size_t fileCount, int iterations)
+    {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "SerializerBenchmark_context";
+        std::filesystem::create_directories(directory);
+
+        std::vector<std::filesystem::path> filePaths;
+        for (size_t i = 0; i < fileCount; ++i)
+        {
+            component fileComponent;
+            fileComponent.field00 = static_cast<float>(i);
+            fileComponent.field59 = static_cast<int>(i);
+            filePaths.push_back(directory / ("component" + std::to_string(i) + ".json"));
+            JSON::SerializeToFile(filePaths.back(), fileComponent, JSON::JsonFormat::Compact);
+        }
+
+        std::printf("\n[Deserialization context] %zu files, %d iterations\n", fileCount, iterations);
+        std::printf("%-12s %12s %16s %16s\n", "Load", "Read(ms)", "Allocations/file", "Allocated/file");
+
+        component target;
+
+        AllocationStats freshAllocations;
+        const double freshTime = MeasureMilliseconds([&]()
+            {
+                for (const std::filesystem::path& filePath : filePaths)
+                {
+                    JSON::DeserializeFromFile(filePath, target);
+                }
+            }, iterations, freshAllocations);
+
+        JSON::DeserializationContext context;
+        // Warm up, sizes the arenas and the file buffer
+        for (const std::filesystem::path& filePath : filePaths)
+        {
+            JSON::DeserializeFromFile(filePath, target, context);
+        }
+
+        AllocationStats contextAllocations;
+        const double contextTime = MeasureMilliseconds([&]()
+            {
+                for (const std::filesystem::path& filePath : filePaths)
+                {
+                    JSON::DeserializeFromFile(filePath, target, context);
+                }
+            }, iterations, contextAllocations);
+
+        const double files = static_cast<double>(fileCount);
+        std::printf("%-12s %12.3f %16.2f %16.1f\n", "Fresh", freshTime, freshAllocations.count / files, freshAllocations.bytes / files);
+        std::printf("%-12s %12.3f %16.2f %16.1f\n", "Context", contextTime, contextAllocations.count / files, contextAllocations.bytes / files);
+        std::printf("Context arena: %zu bytes\n", context.GetArenaSize());
+
+        std::filesystem::remove_all(directory);
+    }
+
+    // Many small saves into memory, ToJsonFormat returning a new std::string per save vs a string_view into one SerializationContext
+    void CompareSerializationContext(size_t saveCount, int iterations)
+    {
+        component message;
+        message.field00 = 1.5f;
+        message.field59 = 42;
+
+        std::printf("\n[Serialization context] %zu saves, %d iterations\n", saveCount, iterations);
+        std::printf("%-12s %12s %16s %16s\n", "Save", "Write(ms)", "Allocations/save", "Allocated/save");
+
+        size_t freshBytes = 0;
+        AllocationStats freshAllocations;
+        const double freshTime = MeasureMilliseconds([&]()
+            {
+                for (size_t i = 0; i < saveCount; ++i)
+                {
+                    freshBytes += JSON::ToJsonFormat(message, JSON::JsonFormat::Compact).size();
+                }
+            }, iterations, freshAllocations);
+
+        JSON::SerializationContext context;
+        // Warm up, sizes the output and the writer stacks
+        const std::string expected{ JSON::ToJsonFormat(message, context, JSON::JsonFormat::Compact) };
+
+        size_t contextBytes = 0;
+        AllocationStats contextAllocations;
+        const double contextTime = MeasureMilliseconds([&]()
+            {
+                for (size_t i = 0; i < saveCount; ++i)
+                {
+                    contextBytes += JSON::ToJsonFormat(message, context, JSON::JsonFormat::Compact).size();
+                }
+            }, iterations, contextAllocations);
+
+        const double saves = static_cast<double>(saveCount);
+        std::printf("%-12s %12.3f %16.2f %16.1f\n", "Fresh", freshTime, freshAllocations.count / saves, freshAllocations.bytes / saves);
+        std::printf("%-12s %12.3f %16.2f %16.1f\n", "Context", contextTime, contextAllocations.count / saves, contextAllocations.bytes / saves);
+
+        if (freshBytes != contextBytes || expected != JSON::ToJsonFormat(message, JSON::JsonFormat::Compact))
+        {
+            ReportFailedCheck("Context output does not match ToJsonFormat!\n");
+        }
+
+        // A pretty save that ends in a single line array must not change the format of the next one
+        inlineWorld prettyWorld;
+        prettyWorld.entities.assign(2, inlineEntity{ "Entity", materialCopy{ "Surface", { 0.5f, 1.f } } });
+        JSON::ToJsonFormat(prettyWorld.entities.front().surface, context, JSON::JsonFormat::Pretty);
+        if (JSON::ToJsonFormat(prettyWorld, context, JSON::JsonFormat::Pretty) != JSON::ToJsonFormat(prettyWorld, JSON::JsonFormat::Pretty))
+        {
+            ReportFailedCheck("Context pretty output does not match ToJsonFormat!\n");
+        }
+    }
+
+    // Runs setup + operation at least minimumRuns times and for at least minimumSeconds, only operation is timed and counted
+    template <typename Setup, typename Operation>
+    SuiteResult MeasureOperation(const char* name, size_t objects, size_t bytes, int minimumRuns, double minimumSeconds, Setup&& setup, Operation&& operation)
+    {
+        SuiteResult result;
+        result.operation = name;
+        result.objects = objects;
+        result.bytes = bytes;
+        double seconds = 0.0;
+        AllocationStats allocations;
+
+        // Warm up, the first run also builds the type plans
+        setup();
+        operation();
+
+        while (result.runs < minimumRuns || seconds < minimumSeconds)
+        {
+            setup();
+
+            const AllocationStats before = GetAllocationStats();
+            const auto start = std::chrono::steady_clock::now();
+            operation();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            const AllocationStats after = GetAllocationStats();
+
+            seconds += elapsed.count();
+            allocations.count += after.count - before.count;
+            allocations.bytes += after.bytes - before.bytes;
+            ++result.runs;
+        }
+
+        const double secondsPerRun = seconds / result.runs;
+        result.nanosecondsPerObject = secondsPerRun * 1e9 / static_cast<double>(objects);
+        result.megabytesPerSecond = static_cast<double>(bytes) / (1024.0 * 1024.0) / secondsPerRun;
+        result.allocationsPerRun = { allocations.count / result.runs, allocations.bytes / result.runs };
+        return result;
+    }
+
+    void PrintSuiteResult(const SuiteResult& result)
+    {
+        std::printf("%-24s %10zu %14zu %6d %14.1f %10.1f %14zu %14.3f\n", result.operation.c_str(), result.objects, result.bytes, result.runs,
+            result.nanosecondsPerObject, result.megabytesPerSecond, result.allocationsPerRun.count, result.allocationsPerRun.bytes / (1024.0 * 1024.0));
+    }
+
+    void RunSuite(size_t objects, int minimumRuns, double minimumSeconds, std::vector<SuiteResult>& results)
+    {
+        const scene syntheticScene = MakeScene(objects);
+        const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "SerializerBenchmark_suite.json";
+        const std::filesystem::path binaryPath = std::filesystem::temp_directory_path() / "SerializerBenchmark_suite.bin";
+        const auto nothing = []() {};
+
+        std::printf("\n[Suite] %zu circles\n", objects);
+        std::printf("%-24s %10s %14s %6s %14s %10s %14s %14s\n", "Operation", "Objects", "Bytes", "Runs", "ns/object", "MB/s", "Allocations", "Allocated(MB)");
+
+        const auto add = [&results](SuiteResult&& result)
+        {
+            PrintSuiteResult(result);
+            results.push_back(std::move(result));
+        };
+
+        const std::string pretty = JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Pretty);
+        const std::string compact = JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Compact);
+        const std::string binary = Binary::ToBinaryFormat(syntheticScene);
+        // Parsing in place destroys the input, every run gets a fresh copy outside of the timed part
+        std::string input;
+        std::unique_ptr<scene> loadedScene;
+
+        add(MeasureOperation("ToJsonFormat(Pretty)", objects, pretty.size(), minimumRuns, minimumSeconds, nothing, [&]()
+            {
+                JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Pretty);
+            }));
+
+        add(MeasureOperation("ToJsonFormat(Compact)", objects, compact.size(), minimumRuns, minimumSeconds, nothing, [&]()
+            {
+                JSON::ToJsonFormat(syntheticScene, JSON::JsonFormat::Compact);
+            }));
+
+        // Every hardware thread, the bytes are the circles array only
+        const size_t batchBytes = JSON::ToJsonFormatBatch(syntheticScene.circles, JSON::JsonFormat::Compact).size();
+        add(MeasureOperation("ToJsonFormatBatch", objects, batchBytes, minimumRuns, minimumSeconds, nothing, [&]()
+            {
+                JSON::ToJsonFormatBatch(syntheticScene.circles, JSON::JsonFormat::Compact);
+            }));
+
+        add(MeasureOperation("FromJsonFormat", objects, pretty.size(), minimumRuns, minimumSeconds, [&]()
+            {
+                input = pretty;
+                loadedScene = std::make_unique<scene>();
+            }, [&]()
+            {
+                JSON::FromJsonFormat(input.data(), *loadedScene);
+            }));
+
+        add(MeasureOperation("FromJsonFormatSax", objects, pretty.size(), minimumRuns, minimumSeconds, [&]()
+            {
+                input = pretty;
+                loadedScene = std::make_unique<scene>();
+            }, [&]()
+            {
+                JSON::FromJsonFormatSax(input.data(), *loadedScene);
+            }));
+
+        // The scene is a single property, so this is parse only vs parse and read it
+        std::unique_ptr<JSON::LazyHandle> lazyHandle;
+        add(MeasureOperation("LazyHandle::Load", objects, pretty.size(), minimumRuns, minimumSeconds, [&]()
+            {
+                loadedScene = std::make_unique<scene>();
+                lazyHandle = std::make_unique<JSON::LazyHandle>(*loadedScene);
+            }, [&]()
+            {
+                lazyHandle->Load(pretty.data(), pretty.size());
+            }));
+
+        add(MeasureOperation("LazyHandle::MaterializeAll", objects, pretty.size(), minimumRuns, minimumSeconds, [&]()
+            {
+                loadedScene = std::make_unique<scene>();
+                lazyHandle = std::make_unique<JSON::LazyHandle>(*loadedScene);
+            }, [&]()
+            {
+                lazyHandle->Load(pretty.data(), pretty.size());
+                lazyHandle->MaterializeAll();
+            }));
+
+        add(MeasureOperation("SerializeToFile", objects, pretty.size(), minimumRuns, minimumSeconds, nothing, [&]()
+            {
+                JSON::SerializeToFile(filePath, syntheticScene);
+            }));
+
+        add(MeasureOperation("DeserializeFromFile", objects, pretty.size(), minimumRuns, minimumSeconds, [&]()
+            {
+                loadedScene = std::make_unique<scene>();
+            }, [&]()
+            {
+                JSON::DeserializeFromFile(filePath, *loadedScene);
+            }));
+
+        add(MeasureOperation("DeserializeFromFileSax", objects, pretty.size(), minimumRuns, minimumSeconds, [&]()
+            {
+                loadedScene = std::make_unique<scene>();
+            }, [&]()
+            {
+                JSON::DeserializeFromFileSax(filePath, *loadedScene);
+            }));
+
+        add(MeasureOperation("ToBinaryFormat", objects, binary.size(), minimumRuns, minimumSeconds, nothing, [&]()
+            {
+                Binary::ToBinaryFormat(syntheticScene);
+            }));
+
+        add(MeasureOperation("FromBinaryFormat", objects, binary.size(), minimumRuns, minimumSeconds, [&]()
+            {
+                loadedScene = std::make_unique<scene>();
+            }, [&]()
+            {
+                Binary::FromBinaryFormat(binary, *loadedScene);
+            }));
+
+        add(MeasureOperation("Binary::SerializeToFile", objects, binary.size(), minimumRuns, minimumSeconds, nothing, [&]()
+            {
+                Binary::SerializeToFile(binaryPath, syntheticScene);
+            }));
+
+        add(MeasureOperation("Binary::DeserializeFromFile", objects, binary.size(), minimumRuns, minimumSeconds, [&]()
+            {
+                loadedScene = std::make_unique<scene>();
+            }, [&]()
+            {
+                Binary::DeserializeFromFile(binaryPath, *loadedScene);
+            }));
+
+        std::filesystem::remove(filePath);
+        std::filesystem::remove(binaryPath);
+    }
+
+    // Machine readable copy of the suite, one entry per operation and size, so runs can be diffed to find regressions
+    bool WriteSuiteResults(const std::filesystem::path& filePath, const std::vector<SuiteResult>& results)
+    {
+        JSON::FilePointer file = JSON::OpenFile(filePath, "wb");
+        if (!file)
+        {
+            std::fprintf(stderr, "Unable to open %s for writing!\n", filePath.string().c_str());
+            return false;
+        }
+
+        char writeBuffer[JSON::WRITE_BUFFER_SIZE];
+        JSON::OutputStream stream{ file.get(), writeBuffer, sizeof(writeBuffer) };
+        rapidjson::PrettyWriter<JSON::OutputStream> writer(stream);
+
+        writer.StartObject();
+        writer.Key("timestamp");
+        writer.Int64(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        writer.Key("compiler");
+#if defined(_MSC_VER)
+        writer.String(("MSVC " + std::to_string(_MSC_VER)).c_str());
+#elif defined(__clang__)
+        writer.String("clang " __clang_version__);
+#elif defined(__GNUC__)
+        writer.String("gcc " __VERSION__);
+#else
+        writer.String("unknown");
+#endif
+        writer.Key("optimized");
+#ifdef NDEBUG
+        writer.Bool(true);
+#else
+        writer.Bool(false);
+#endif
+        writer.Key("results");
+        writer.StartArray();
+        for (const SuiteResult& result : results)
+        {
+            writer.StartObject();
+            writer.Key("operation");
+            writer.String(result.operation.c_str());
+            writer.Key("objects");
+            writer.Uint64(result.objects);
+            writer.Key("bytes");
+            writer.Uint64(result.bytes);
+            writer.Key("runs");
+            writer.Int(result.runs);
+            writer.Key("nsPerObject");
+            writer.Double(result.nanosecondsPerObject);
+            writer.Key("mbPerSecond");
+            writer.Double(result.megabytesPerSecond);
+            writer.Key("allocationsPerRun");
+            writer.Uint64(result.allocationsPerRun.count);
+            writer.Key("allocatedBytesPerRun");
+            writer.Uint64(result.allocationsPerRun.bytes);
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+
+        stream.Put('\n');
+        stream.Flush();
+        return stream.Good();
+    }
+
+    // "1000,100000" -> { 1000, 100000 }
+    std::vector<size_t> ParseSizes(const std::string& sizes)
+    {
+        std::vector<size_t> parsed;
+        std::stringstream stream{ sizes };
+        std::string size;
+        while (std::getline(stream, size, ','))
+        {
+            parsed.push_back(std::stoul(size));
+        }
+        return parsed;
+    }
+}
+
+RTTR_REGISTRATION
+{
+    using namespace rttr;
+
+    registration::class_<Benchmark::scene>("scene")
+        .constructor()(policy::ctor::as_object)
+        .property("circles", &Benchmark::scene::circles);
+
+    registration::class_<Benchmark::mesh>("mesh")
+        .constructor()(policy::ctor::as_object)
+        .property("vertices", &Benchmark::mesh::vertices)
+        .property("transform", &Benchmark::mesh::transform);
+
+    registration::class_<Benchmark::bodyList<Benchmark::body>>("bodyList<body>")
+        .constructor()(policy::ctor::as_object)
+        .property("bodies", &Benchmark::bodyList<Benchmark::body>::bodies);
+
+    registration::class_<Benchmark::bodyList<Benchmark::listedBody>>("bodyList<listedBody>")
+        .constructor()(policy::ctor::as_object)
+        .property("bodies", &Benchmark::bodyList<Benchmark::listedBody>::bodies);
+
+    registration::class_<Benchmark::body> bodyClass("body");
+    bodyClass.constructor()(policy::ctor::as_object);
+#define FIELD(Type, Name) bodyClass.property(#Name, &Benchmark::body::Name);
+    BENCHMARK_BODY_FIELDS(FIELD)
+#undef FIELD
+
+    registration::class_<Benchmark::listedBody> listedBodyClass("listedBody");
+    listedBodyClass.constructor()(policy::ctor::as_object);
+#define FIELD(Type, Name) listedBodyClass.property(#Name, &Benchmark::listedBody::Name);
+    BENCHMARK_BODY_FIELDS(FIELD)
+#undef FIELD
+
+    registration::class_<Benchmark::material>("material")
+        .constructor()(policy::ctor::as_object)
+        .property("name", &Benchmark::material::name)
+        .property("parameters", &Benchmark::material::parameters)
+        .property("fallback", &Benchmark::material::fallback);
+
+    registration::class_<Benchmark::entity>("entity")
+        .constructor()(policy::ctor::as_object)
+        .property("name", &Benchmark::entity::name)
+        .property("surface", &Benchmark::entity::surface);
+
+    registration::class_<Benchmark::world>("world")
+        .constructor()(policy::ctor::as_object)
+        .property("entities", &Benchmark::world::entities);
+
+    registration::class_<Benchmark::materialCopy>("materialCopy")
+        .constructor()(policy::ctor::as_object)
+        .property("name", &Benchmark::materialCopy::name)
+        .property("parameters", &Benchmark::materialCopy::parameters);
+
+    registration::class_<Benchmark::inlineEntity>("inlineEntity")
+        .constructor()(policy::ctor::as_object)
+        .property("name", &Benchmark::inlineEntity::name)
+        .property("surface", &Benchmark::inlineEntity::surface);
+
+    registration::class_<Benchmark::inlineWorld>("inlineWorld")
+        .constructor()(policy::ctor::as_object)
+        .property("entities", &Benchmark::inlineWorld::entities);
+
+    registration::class_<Benchmark::component> componentClass("component");
+    componentClass.constructor()(policy::ctor::as_object);
+#define FIELD(Type, Name) componentClass.property(#Name, &Benchmark::component::Name);
+    BENCHMARK_COMPONENT_FIELDS(FIELD)
+#undef FIELD
+}
+
+// Usage: SerializerBenchmark [--sizes 1000,100000,1000000] [--runs 3] [--seconds 0.5] [--output results.json]
+//                            [--compare circleCount] [--iterations 5] [--no-suite] [--no-compare]
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> sizes{ 1000, 100000, 1000000 };
+    int minimumRuns = 3;
+    double minimumSeconds = 0.5;
+    std::filesystem::path outputPath = "benchmark_results.json";
+    size_t circleCount = 10000;
+    int iterations = 5;
+    bool runSuite = true;
+    bool runComparisons = true;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (argument == "--sizes" && hasValue)
+            sizes = Benchmark::ParseSizes(argv[++i]);
+        else if (argument == "--runs" && hasValue)
+            minimumRuns = std::stoi(argv[++i]);
+        else if (argument == "--seconds" && hasValue)
+            minimumSeconds = std::stod(argv[++i]);
+        else if (argument == "--output" && hasValue)
+            outputPath = argv[++i];
+        else if (argument == "--compare" && hasValue)
+            circleCount = std::stoul(argv[++i]);
+        else if (argument == "--iterations" && hasValue)
+            iterations = std::stoi(argv[++i]);
+        else if (argument == "--no-suite")
+            runSuite = false;
+        else if (argument == "--no-compare")
+            runComparisons = false;
+        else
+        {
+            std::fprintf(stderr, "Unknown argument %s\n", argument.c_str());
+            return 1;
+        }
+    }
+
+    // Every std::array<T, N> is its own type, so it is registered explicitly before the first save
+    JSON::RegisterContiguousContainer<std::array<float, 16>>();
+    // Hot types skip the per property RTTR walk, listedBody is the member list half of CompareMemberList
+    // Its plan is built before the registration on purpose, CompareMemberList checks the plan still picked up the member list
+    JSON::GetTypePlan(rttr::type::get<Benchmark::listedBody>());
+    JSON::RegisterMemberList<Reflect::point2d>();
+    JSON::RegisterMemberList<Reflect::Vector3>();
+    JSON::RegisterMemberList<Benchmark::listedBody>();
+    JSON::RegisterReference<std::shared_ptr<Benchmark::material>>();
+    JSON::RegisterReference<Benchmark::material*>();
+    // JSON Patch and partial load paths go through these without copying them
+    JSON::RegisterPropertyReference<&Benchmark::scene::circles>("circles");
+    JSON::RegisterPropertyReference<&Reflect::circle::points>("points");
+
+    if (runSuite)
+    {
+        std::vector<Benchmark::SuiteResult> results;
+        for (const size_t size : sizes)
+        {
+            Benchmark::RunSuite(size, minimumRuns, minimumSeconds, results);
+        }
+
+        if (!Benchmark::WriteSuiteResults(outputPath, results))
+        {
+            return 1;
+        }
+        std::printf("\nResults written to %s\n", outputPath.string().c_str());
+    }
+
+    // Before/after comparisons of the individual optimizations
+    if (runComparisons)
+    {
+        const Benchmark::scene syntheticScene = Benchmark::MakeScene(circleCount);
+
+        Benchmark::CompareJsonFormats(syntheticScene, iterations);
+        Benchmark::CompareLoadPaths(syntheticScene, iterations);
+        Benchmark::CompareMemberMatching(circleCount, iterations);
+        Benchmark::CompareContiguousContainers(circleCount * 100, iterations);
+        Benchmark::CompareBinaryFormat(syntheticScene, iterations);
+        Benchmark::CompareMemberList(circleCount * 10, iterations);
+        Benchmark::CompareDeltaSerialization(syntheticScene, iterations);
+        Benchmark::CompareJsonPatch(syntheticScene, iterations);
+        Benchmark::ComparePartialLoad(syntheticScene, iterations);
+        Benchmark::CompareLazyLoad(circleCount, iterations);
+        Benchmark::CompareObjectGraph(circleCount, iterations);
+        Benchmark::CompareParallelSerialization(syntheticScene, iterations);
+        Benchmark::CompareLogger(circleCount * 10, iterations);
+        Benchmark::CompareDiagnostics(syntheticScene, iterations);
+        Benchmark::CompareTracing(syntheticScene, iterations);
+        Benchmark::CompareMethodHandle(syntheticScene, iterations);
+        Benchmark::CompareGlobalFunctionBatch(circleCount * 100, iterations);
+        Benchmark::CompareParallelDeserialization(syntheticScene, iterations);
+        Benchmark::CompareDeserializationContext(1000, iterations);
+        Benchmark::CompareSerializationContext(1000, iterations);
+    }
+
+    if (Benchmark::g_FailedCheckCount > 0)
+    {
+        std::fprintf(stderr, "%zu checks failed\n", Benchmark::g_FailedCheckCount);
+        return 1;
+    }
+    return 0;
+}
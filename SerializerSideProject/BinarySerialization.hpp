@@ -0,0 +1,614 @@
+/******************************************************************************/
+/*!
+\file       BinarySerialization.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _BINARY_SERIALIZATION_HPP_
+#define _BINARY_SERIALIZATION_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Serialization.hpp"
+
+/*  Tagged binary format for data no human reads (runtime caches, save games).
+
+    It goes through the exact same RTTR walk as the JSON path: Encoder is an output handler for JSON::GenericWriter,
+    and Decoder drives JSON::SaxReader, so every type the JSON path supports (enums, maps, nested objects...) works here too.
+
+    Layout: MAGIC, VERSION, then the root object. Every value starts with a Tag.
+    - Integers are varints (signed ones zigzag encoded), floats/doubles are raw IEEE 754, little endian
+    - Strings and arrays are length prefixed, objects run until Tag::End
+    - Properties are written as their index in the TypePlan instead of their name, so a file can only be read back
+      by a build that registers the same properties in the same order
+ */
+
+namespace Binary
+{
+    using namespace rttr;
+
+    constexpr char MAGIC[4] = { 'R', 'T', 'B', 'N' };
+    constexpr uint8_t VERSION = 1;
+    // Deeper than this is treated as a corrupted file instead of running out of stack
+    constexpr size_t MAX_DEPTH = 1024;
+
+    enum class Tag : uint8_t
+    {
+        Null,
+        False,
+        True,
+        Int,            // Zigzag varint, any signed integer up to 64 bits
+        Uint,           // Varint, any unsigned integer up to 64 bits
+        Float,          // 4 bytes
+        Double,         // 8 bytes
+        String,         // Varint length + bytes, no terminator
+        Array,          // Varint count + count values
+        OpenArray,      // Values until End, only from GenericWriter::StartArray() without a count
+        Object,         // Members until End, a member is a PropertyId or Key followed by its value
+        End,
+        PropertyId,     // Varint index into the TypePlan of the enclosing object
+        Key             // Varint length + bytes, for members that are not properties ({"key","value"} entries)
+    };
+
+    // *********************************************************
+    // *Output handler for JSON::GenericWriter, same functions as rapidjson::Writer plus the sized StartArray, PropertyId and Float
+    // *********************************************************
+    class Encoder
+    {
+    public:
+        Encoder(JSON::OutputStream& stream) : m_Stream{ &stream }
+        {
+        }
+
+        bool Null()
+        {
+            CountValue();
+            PutTag(Tag::Null);
+            return true;
+        }
+
+        bool Bool(bool value)
+        {
+            CountValue();
+            PutTag(value ? Tag::True : Tag::False);
+            return true;
+        }
+
+        bool Int(int value)
+        {
+            return Int64(value);
+        }
+
+        bool Uint(unsigned value)
+        {
+            return Uint64(value);
+        }
+
+        bool Int64(int64_t value)
+        {
+            CountValue();
+            PutTag(Tag::Int);
+            // Zigzag, small negative numbers stay small
+            PutVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+            return true;
+        }
+
+        bool Uint64(uint64_t value)
+        {
+            CountValue();
+            PutTag(Tag::Uint);
+            PutVarint(value);
+            return true;
+        }
+
+        bool Float(float value)
+        {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            CountValue();
+            PutTag(Tag::Float);
+            PutFixed(bits, sizeof(bits));
+            return true;
+        }
+
+        bool Double(double value)
+        {
+            uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            CountValue();
+            PutTag(Tag::Double);
+            PutFixed(bits, sizeof(bits));
+            return true;
+        }
+
+        bool String(const char* string, rapidjson::SizeType length, bool = false)
+        {
+            CountValue();
+            PutTag(Tag::String);
+            PutBytes(string, length);
+            return true;
+        }
+
+        bool String(const char* string)
+        {
+            return String(string, static_cast<rapidjson::SizeType>(std::strlen(string)));
+        }
+
+        bool StartObject()
+        {
+            CountValue();
+            PutTag(Tag::Object);
+            m_Levels.push_back(Level{ false, 0, 0 });
+            return true;
+        }
+
+        bool Key(const char* name, rapidjson::SizeType length, bool = false)
+        {
+            PutTag(Tag::Key);
+            PutBytes(name, length);
+            return true;
+        }
+
+        bool Key(const char* name)
+        {
+            return Key(name, static_cast<rapidjson::SizeType>(std::strlen(name)));
+        }
+
+        bool PropertyId(uint32_t index)
+        {
+            PutTag(Tag::PropertyId);
+            PutVarint(index);
+            return true;
+        }
+
+        bool EndObject(rapidjson::SizeType = 0)
+        {
+            PutTag(Tag::End);
+            m_Levels.pop_back();
+            return true;
+        }
+
+        bool StartArray()
+        {
+            CountValue();
+            PutTag(Tag::OpenArray);
+            m_Levels.push_back(Level{ false, 0, 0 });
+            return true;
+        }
+
+        bool StartArray(rapidjson::SizeType count)
+        {
+            CountValue();
+            PutTag(Tag::Array);
+            PutVarint(count);
+            m_Levels.push_back(Level{ true, count, 0 });
+            return true;
+        }
+
+        bool EndArray(rapidjson::SizeType = 0)
+        {
+            const Level level = m_Levels.back();
+            if (!level.sized)
+            {
+                PutTag(Tag::End);
+            }
+            else if (level.written != level.count)
+            {
+                // An element the walk could not write, the count is already out so the rest is padded to keep the file readable
+                m_Good = false;
+                for (size_t i = level.written; i < level.count; ++i)
+                {
+                    PutTag(Tag::Null);
+                }
+            }
+            m_Levels.pop_back();
+            return true;
+        }
+
+        // False if an array did not get the number of elements it was started with
+        bool Good() const
+        {
+            return m_Good && m_Levels.empty();
+        }
+
+    private:
+        struct Level
+        {
+            bool sized;
+            size_t count;
+            size_t written;
+        };
+
+        void CountValue()
+        {
+            if (!m_Levels.empty())
+            {
+                ++m_Levels.back().written;
+            }
+        }
+
+        void PutTag(Tag tag)
+        {
+            m_Stream->Put(static_cast<char>(tag));
+        }
+
+        void PutVarint(uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                m_Stream->Put(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            m_Stream->Put(static_cast<char>(value));
+        }
+
+        // Little endian, whatever the machine is
+        void PutFixed(uint64_t bits, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                m_Stream->Put(static_cast<char>((bits >> (i * 8)) & 0xFF));
+            }
+        }
+
+        void PutBytes(const char* bytes, size_t length)
+        {
+            PutVarint(length);
+            for (size_t i = 0; i < length; ++i)
+            {
+                m_Stream->Put(bytes[i]);
+            }
+        }
+
+        // Private Variables
+        JSON::OutputStream* m_Stream = nullptr;
+        std::vector<Level> m_Levels;
+        bool m_Good = true;
+    };
+
+    using Writer = JSON::GenericWriter<Encoder>;
+
+    // *********************************************************
+    // *Reads what Encoder wrote and sends it to a SAX handler with the rapidjson::Reader handler functions + PropertyId (JSON::SaxReader)
+    // *Every read is bounds checked, a truncated or corrupted buffer makes Parse return false
+    // *********************************************************
+    class Decoder
+    {
+    public:
+        Decoder(const char* data, size_t size) : m_Current{ data }, m_End{ data + size }
+        {
+        }
+
+        // Where decoding stopped, the failing read when Parse returned false
+        const char* GetPosition() const
+        {
+            return m_Current;
+        }
+
+        template <typename Handler>
+        bool Parse(Handler& handler)
+        {
+            uint8_t version = 0;
+            if (static_cast<size_t>(m_End - m_Current) < sizeof(MAGIC) || std::memcmp(m_Current, MAGIC, sizeof(MAGIC)) != 0)
+            {
+                return false;
+            }
+            m_Current += sizeof(MAGIC);
+            if (!ReadByte(version) || version != VERSION)
+            {
+                return false;
+            }
+
+            // One root value and nothing after it
+            return ParseValue(handler, 0) && m_Current == m_End;
+        }
+
+    private:
+        template <typename Handler>
+        bool ParseValue(Handler& handler, size_t depth)
+        {
+            uint8_t tag = 0;
+            if (depth > MAX_DEPTH || !ReadByte(tag))
+            {
+                return false;
+            }
+
+            switch (static_cast<Tag>(tag))
+            {
+                case Tag::Null:
+                    return handler.Null();
+                case Tag::False:
+                    return handler.Bool(false);
+                case Tag::True:
+                    return handler.Bool(true);
+                case Tag::Int:
+                {
+                    uint64_t zigzag = 0;
+                    return ReadVarint(zigzag) && handler.Int64(static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1));
+                }
+                case Tag::Uint:
+                {
+                    uint64_t value = 0;
+                    return ReadVarint(value) && handler.Uint64(value);
+                }
+                case Tag::Float:
+                {
+                    uint64_t bits = 0;
+                    float value = 0.0f;
+                    if (!ReadFixed(bits, sizeof(float)))
+                        return false;
+                    const uint32_t floatBits = static_cast<uint32_t>(bits);
+                    std::memcpy(&value, &floatBits, sizeof(value));
+                    return handler.Double(value);
+                }
+                case Tag::Double:
+                {
+                    uint64_t bits = 0;
+                    double value = 0.0;
+                    if (!ReadFixed(bits, sizeof(double)))
+                        return false;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    return handler.Double(value);
+                }
+                case Tag::String:
+                {
+                    const char* string = nullptr;
+                    rapidjson::SizeType length = 0;
+                    return ReadBytes(string, length) && handler.String(string, length, false);
+                }
+                case Tag::Array:
+                {
+                    uint64_t count = 0;
+                    if (!ReadVarint(count) || !handler.StartArray())
+                        return false;
+                    for (uint64_t i = 0; i < count; ++i)
+                    {
+                        if (!ParseValue(handler, depth + 1))
+                            return false;
+                    }
+                    return handler.EndArray(static_cast<rapidjson::SizeType>(count));
+                }
+                case Tag::OpenArray:
+                {
+                    if (!handler.StartArray())
+                        return false;
+                    rapidjson::SizeType count = 0;
+                    while (!PeekEnd())
+                    {
+                        if (!ParseValue(handler, depth + 1))
+                            return false;
+                        ++count;
+                    }
+                    return handler.EndArray(count);
+                }
+                case Tag::Object:
+                    return ParseObject(handler, depth);
+                default:
+                    return false;
+            }
+        }
+
+        template <typename Handler>
+        bool ParseObject(Handler& handler, size_t depth)
+        {
+            if (!handler.StartObject())
+            {
+                return false;
+            }
+
+            rapidjson::SizeType memberCount = 0;
+            for (;;)
+            {
+                uint8_t tag = 0;
+                if (!ReadByte(tag))
+                {
+                    return false;
+                }
+
+                switch (static_cast<Tag>(tag))
+                {
+                    case Tag::End:
+                        return handler.EndObject(memberCount);
+                    case Tag::PropertyId:
+                    {
+                        uint64_t index = 0;
+                        if (!ReadVarint(index) || index > UINT32_MAX || !handler.PropertyId(static_cast<uint32_t>(index)))
+                            return false;
+                        break;
+                    }
+                    case Tag::Key:
+                    {
+                        const char* name = nullptr;
+                        rapidjson::SizeType length = 0;
+                        if (!ReadBytes(name, length) || !handler.Key(name, length, false))
+                            return false;
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+
+                if (!ParseValue(handler, depth + 1))
+                {
+                    return false;
+                }
+                ++memberCount;
+            }
+        }
+
+        // Consumes the End tag if it is next
+        bool PeekEnd()
+        {
+            if (m_Current != m_End && static_cast<Tag>(*m_Current) == Tag::End)
+            {
+                ++m_Current;
+                return true;
+            }
+            return false;
+        }
+
+        bool ReadByte(uint8_t& value)
+        {
+            if (m_Current == m_End)
+            {
+                return false;
+            }
+            value = static_cast<uint8_t>(*m_Current++);
+            return true;
+        }
+
+        bool ReadVarint(uint64_t& value)
+        {
+            value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                uint8_t byte = 0;
+                if (!ReadByte(byte))
+                {
+                    return false;
+                }
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            // More than 10 bytes, not something Encoder writes
+            return false;
+        }
+
+        bool ReadFixed(uint64_t& bits, size_t size)
+        {
+            if (static_cast<size_t>(m_End - m_Current) < size)
+            {
+                return false;
+            }
+            bits = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                bits |= static_cast<uint64_t>(static_cast<uint8_t>(m_Current[i])) << (i * 8);
+            }
+            m_Current += size;
+            return true;
+        }
+
+        // Points into the buffer, nothing is copied
+        bool ReadBytes(const char*& bytes, rapidjson::SizeType& length)
+        {
+            uint64_t size = 0;
+            if (!ReadVarint(size) || size > static_cast<uint64_t>(m_End - m_Current))
+            {
+                return false;
+            }
+            bytes = m_Current;
+            length = static_cast<rapidjson::SizeType>(size);
+            m_Current += size;
+            return true;
+        }
+
+        // Private Variables
+        const char* m_Current = nullptr;
+        const char* m_End = nullptr;
+    };
+
+    // *********************************************************
+    // *Exposed functions, same as JSON::ToJsonFormat/SerializeToFile/FromJsonFormat/DeserializeFromFile but binary
+    // *********************************************************
+    // Runs the RTTR walk with the binary encoder, output goes into stream
+    inline bool WriteToStream(JSON::OutputStream& stream, const instance& obj)
+    {
+        for (const char magic : MAGIC)
+        {
+            stream.Put(magic);
+        }
+        stream.Put(static_cast<char>(VERSION));
+
+        Encoder encoder{ stream };
+        Writer ownWriter{ encoder };
+        ownWriter.WriteToJSONRecursively(obj);
+        return encoder.Good();
+    }
+
+    inline std::string ToBinaryFormat(const instance& obj)
+    {
+        if (!obj.is_valid())
+        {
+            JSON::ReportDiagnostic(JSON::ErrorCode::InvalidObject);
+            return std::string();
+        }
+
+        std::string binary;
+        char writeBuffer[JSON::WRITE_BUFFER_SIZE];
+        JSON::OutputStream stream{ binary, writeBuffer, sizeof(writeBuffer) };
+        WriteToStream(stream, obj);
+        stream.Flush();
+        return binary;
+    }
+
+    inline JSON::SerializationResult SerializeToFile(const std::filesystem::path& filePath, const instance& obj)
+    {
+        if (!obj.is_valid())
+        {
+            return JSON::ReportError(JSON::ErrorCode::InvalidObject);
+        }
+
+        JSON::FilePointer file = JSON::OpenFile(filePath, "wb");
+        if (!file)
+        {
+            return JSON::ReportError(JSON::ErrorCode::FileNotWritable, filePath.u8string());
+        }
+
+        char writeBuffer[JSON::WRITE_BUFFER_SIZE];
+        JSON::OutputStream stream{ file.get(), writeBuffer, sizeof(writeBuffer) };
+        const bool isComplete = WriteToStream(stream, obj);
+        stream.Flush();
+        return isComplete && stream.Good() ? JSON::SerializationResult{} : JSON::ReportError(JSON::ErrorCode::FileWriteFailed, filePath.u8string());
+    }
+
+    inline JSON::SerializationResult FromBinaryFormat(const char* data, size_t size, instance rttrObject)
+    {
+        JSON::SaxReader handler{ rttrObject };
+        Decoder decoder{ data, size };
+        if (!decoder.Parse(handler) || !handler.IsComplete())
+        {
+            return JSON::ReportError(JSON::ErrorCode::ParseError, "Binary data is not valid", static_cast<size_t>(decoder.GetPosition() - data));
+        }
+        return JSON::SerializationResult{};
+    }
+
+    inline JSON::SerializationResult FromBinaryFormat(const std::string& binary, instance rttrObject)
+    {
+        return FromBinaryFormat(binary.data(), binary.size(), rttrObject);
+    }
+
+    // Reads the file once into an owned buffer and decodes it from there
+    inline JSON::SerializationResult DeserializeFromFile(const std::filesystem::path& filePath, instance rttrObject)
+    {
+        JSON::InsituBuffer buffer;
+        if (!buffer.ReadFile(filePath))
+        {
+            return JSON::ReportError(JSON::ErrorCode::FileNotFound, filePath.u8string());
+        }
+        return FromBinaryFormat(buffer.GetData(), buffer.GetSize(), rttrObject);
+    }
+
+    // Same as above with the file contents in the buffer of context, the decoder needs no Document or parse stack
+    inline JSON::SerializationResult DeserializeFromFile(const std::filesystem::path& filePath, instance rttrObject, JSON::DeserializationContext& context)
+    {
+        JSON::InsituBuffer& buffer = context.GetBuffer();
+        if (!buffer.ReadFile(filePath))
+        {
+            return JSON::ReportError(JSON::ErrorCode::FileNotFound, filePath.u8string());
+        }
+        return FromBinaryFormat(buffer.GetData(), buffer.GetSize(), rttrObject);
+    }
+}
+
+#endif
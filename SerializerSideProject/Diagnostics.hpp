@@ -0,0 +1,337 @@
+/******************************************************************************/
+/*!
+\file       Diagnostics.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _DIAGNOSTICS_HPP_
+#define _DIAGNOSTICS_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rttr/type.h"
+
+/*  Diagnostics of the serializer, nothing is printed by the library itself.
+    The load and save functions return a SerializationResult, the problems along the way (a property that could not
+    be read, a value that does not fit its property) go to the DiagnosticSink set with JSON::SetDiagnosticSink,
+    with the JSON path, the property and the type they happened at.
+
+    No sink is set by default, then reporting is one atomic load and a branch, and no path is kept while walking.
+    JSON::ConsoleDiagnosticSink prints like the library used to, JSON::DiagnosticCollector keeps them for later.
+ */
+
+namespace JSON
+{
+    enum class ErrorCode : uint8_t
+    {
+        None = 0,
+        InvalidObject,
+        FileNotFound,
+        FileNotWritable,
+        FileWriteFailed,
+        EmptyBuffer,
+        ParseError,
+        UnexpectedLayout,
+        PropertyNotReadable,
+        PropertyNotWritten,
+        ValueMismatch,
+        MissingKey,
+        UnsupportedType,
+        RegistrationMismatch,
+        PatchFailed
+    };
+
+    inline const char* GetErrorDescription(ErrorCode code)
+    {
+        switch (code)
+        {
+        case ErrorCode::None:                   return "Success";
+        case ErrorCode::InvalidObject:          return "RTTR object is not valid";
+        case ErrorCode::FileNotFound:           return "File could not be opened for reading";
+        case ErrorCode::FileNotWritable:        return "File could not be opened for writing";
+        case ErrorCode::FileWriteFailed:        return "Writing to the file failed";
+        case ErrorCode::EmptyBuffer:            return "Buffer is empty";
+        case ErrorCode::ParseError:             return "Parsing failed";
+        case ErrorCode::UnexpectedLayout:       return "Input does not have the expected layout";
+        case ErrorCode::PropertyNotReadable:    return "Unable to retrieve property value";
+        case ErrorCode::PropertyNotWritten:     return "Cannot serialize property";
+        case ErrorCode::ValueMismatch:          return "Value does not fit the property";
+        case ErrorCode::MissingKey:             return "Key is not in the JSON object";
+        case ErrorCode::UnsupportedType:        return "Type is not supported";
+        case ErrorCode::RegistrationMismatch:   return "Registration does not match the RTTR properties";
+        case ErrorCode::PatchFailed:            return "Patch operation failed";
+        default:                                return "Unknown error";
+        }
+    }
+
+    // *********************************************************
+    // *Returned by the load and save functions, if (!result) to check for failure
+    // *********************************************************
+    struct SerializationResult
+    {
+        ErrorCode code = ErrorCode::None;
+        // Offset into the input of a ParseError, index of a failed patch operation
+        size_t offset = 0;
+
+        explicit operator bool() const
+        {
+            return code == ErrorCode::None;
+        }
+
+        const char* GetDescription() const
+        {
+            return GetErrorDescription(code);
+        }
+    };
+
+    inline SerializationResult MakeError(ErrorCode code, size_t offset = 0)
+    {
+        return SerializationResult{ code, offset };
+    }
+
+    // Only valid during DiagnosticSink::Report, copy what has to be kept
+    struct Diagnostic
+    {
+        ErrorCode code;
+        // JSON Pointer of the value, empty when it is not known (root, SAX reader, binary format)
+        std::string_view path;
+        // Property name, empty when the diagnostic is not about a property
+        std::string_view property;
+        // Type of the value, void when the diagnostic is not about a value
+        rttr::type valueType;
+        // File path, parse error offset etc.
+        std::string_view detail;
+    };
+
+    // Report can be called from the worker threads of the batch functions at the same time
+    class DiagnosticSink
+    {
+    public:
+        virtual ~DiagnosticSink() = default;
+        virtual void Report(const Diagnostic& diagnostic) = 0;
+    };
+
+    // Prints every diagnostic to std::cerr
+    class ConsoleDiagnosticSink : public DiagnosticSink
+    {
+    public:
+        void Report(const Diagnostic& diagnostic) override
+        {
+            std::lock_guard<std::mutex> lock{ m_Mutex };
+            std::cerr << GetErrorDescription(diagnostic.code);
+            if (!diagnostic.path.empty())
+                std::cerr << " at " << diagnostic.path;
+            if (!diagnostic.property.empty())
+                std::cerr << " (" << diagnostic.property << " : " << diagnostic.valueType.get_name() << ")";
+            if (!diagnostic.detail.empty())
+                std::cerr << ": " << diagnostic.detail;
+            std::cerr << std::endl;
+        }
+
+    private:
+        std::mutex m_Mutex;
+    };
+
+    // Keeps a copy of every diagnostic
+    class DiagnosticCollector : public DiagnosticSink
+    {
+    public:
+        struct Entry
+        {
+            ErrorCode code;
+            std::string path;
+            std::string property;
+            rttr::type valueType;
+            std::string detail;
+        };
+
+        void Report(const Diagnostic& diagnostic) override
+        {
+            std::lock_guard<std::mutex> lock{ m_Mutex };
+            m_Entries.push_back(Entry{ diagnostic.code, std::string(diagnostic.path), std::string(diagnostic.property), diagnostic.valueType, std::string(diagnostic.detail) });
+        }
+
+        std::vector<Entry> TakeEntries()
+        {
+            std::lock_guard<std::mutex> lock{ m_Mutex };
+            return std::move(m_Entries);
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::vector<Entry> m_Entries;
+    };
+
+    inline std::atomic<DiagnosticSink*>& GetDiagnosticSinkSlot()
+    {
+        static std::atomic<DiagnosticSink*> sink{ nullptr };
+        return sink;
+    }
+
+    // nullptr turns diagnostics off, sink has to outlive every load and save that runs while it is set
+    inline void SetDiagnosticSink(DiagnosticSink* sink)
+    {
+        GetDiagnosticSinkSlot().store(sink, std::memory_order_release);
+    }
+
+    inline DiagnosticSink* GetDiagnosticSink()
+    {
+        return GetDiagnosticSinkSlot().load(std::memory_order_acquire);
+    }
+
+    inline void ReportDiagnostic(ErrorCode code, std::string_view detail = std::string_view())
+    {
+        if (DiagnosticSink* sink = GetDiagnosticSink())
+        {
+            sink->Report(Diagnostic{ code, std::string_view(), std::string_view(), rttr::type::get<void>(), detail });
+        }
+    }
+
+    // Same as above for a value whose path is not known
+    inline void ReportDiagnostic(ErrorCode code, std::string_view property, const rttr::type& valueType, std::string_view detail = std::string_view())
+    {
+        if (DiagnosticSink* sink = GetDiagnosticSink())
+        {
+            sink->Report(Diagnostic{ code, std::string_view(), property, valueType, detail });
+        }
+    }
+
+    // Same as ReportDiagnostic and returns the error, for return ReportError(...) at the failure
+    inline SerializationResult ReportError(ErrorCode code, std::string_view detail = std::string_view(), size_t offset = 0)
+    {
+        ReportDiagnostic(code, detail);
+        return MakeError(code, offset);
+    }
+
+    // *********************************************************
+    // *Keys and indices from the root to the value being read or written, only kept while a sink is set
+    // *********************************************************
+    class DiagnosticPath
+    {
+    public:
+        DiagnosticPath() : m_IsTracking{ GetDiagnosticSink() != nullptr }
+        {
+        }
+
+        bool IsTracking() const
+        {
+            return m_IsTracking;
+        }
+
+        void Push(std::string_view key)
+        {
+            if (m_IsTracking)
+                m_Segments.push_back(Segment{ key, 0 });
+        }
+
+        void Push(size_t index)
+        {
+            if (m_IsTracking)
+                m_Segments.push_back(Segment{ std::string_view(), index });
+        }
+
+        void Pop()
+        {
+            if (m_IsTracking)
+                m_Segments.pop_back();
+        }
+
+        // JSON Pointer of the current value, with key appended if it is not empty
+        std::string ToString(std::string_view key = std::string_view()) const
+        {
+            std::string path;
+            for (const Segment& segment : m_Segments)
+            {
+                path += '/';
+                if (segment.key.data() != nullptr)
+                    AppendEscaped(path, segment.key);
+                else
+                    path += std::to_string(segment.index);
+            }
+            if (!key.empty())
+            {
+                path += '/';
+                AppendEscaped(path, key);
+            }
+            return path;
+        }
+
+        // Reports code for the property key of valueType under the current path
+        void Report(ErrorCode code, std::string_view key, const rttr::type& valueType, std::string_view detail = std::string_view()) const
+        {
+            if (DiagnosticSink* sink = GetDiagnosticSink())
+            {
+                const std::string path = ToString(key);
+                sink->Report(Diagnostic{ code, path, key, valueType, detail });
+            }
+        }
+
+        // Same as above for the value at the current path itself, property is the key it was pushed with
+        void ReportCurrent(ErrorCode code, std::string_view property, const rttr::type& valueType, std::string_view detail = std::string_view()) const
+        {
+            if (DiagnosticSink* sink = GetDiagnosticSink())
+            {
+                const std::string path = ToString();
+                sink->Report(Diagnostic{ code, path, property, valueType, detail });
+            }
+        }
+
+    private:
+        struct Segment
+        {
+            // Null data for an array index
+            std::string_view key;
+            size_t index;
+        };
+
+        // ~ and / are written as ~0 and ~1 in a JSON Pointer
+        static void AppendEscaped(std::string& path, std::string_view key)
+        {
+            for (const char character : key)
+            {
+                if (character == '~')
+                    path += "~0";
+                else if (character == '/')
+                    path += "~1";
+                else
+                    path += character;
+            }
+        }
+
+        bool m_IsTracking;
+        std::vector<Segment> m_Segments;
+    };
+
+    // Pushes a path segment for the lifetime of the scope
+    class DiagnosticPathScope
+    {
+    public:
+        template <typename Segment>
+        DiagnosticPathScope(DiagnosticPath& path, Segment segment) : m_Path{ path }
+        {
+            m_Path.Push(segment);
+        }
+
+        ~DiagnosticPathScope()
+        {
+            m_Path.Pop();
+        }
+
+        DiagnosticPathScope(const DiagnosticPathScope&) = delete;
+        DiagnosticPathScope& operator=(const DiagnosticPathScope&) = delete;
+
+    private:
+        DiagnosticPath& m_Path;
+    };
+}
+
+#endif
@@ -0,0 +1,806 @@
+/******************************************************************************/
+/*!
+\file       JsonPatch.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _JSON_PATCH_HPP_
+#define _JSON_PATCH_HPP_
+
+#include <cstring>
+#include <string>
+
+#include "Serialization.hpp"
+#include "rapidjson/pointer.h"
+
+/*  JSON Patch (RFC 6902) and JSON Merge Patch (RFC 7386) applied straight onto a live RTTR instance,
+    so a tool that changes one field does not have to reload the whole file.
+
+    Paths are JSON Pointers (RFC 6901), resolved through the same layout the Writer writes:
+    - Object      -> /property
+    - Sequential  -> /index, "-" is one past the last element (add only)
+    - Associative -> /index of the entry in iteration order, then /key or /value, e.g. /dictionary/2/value/x
+                     Entries of key only containers (set) are their key, they have no /key or /value
+    Only the values on the path are touched. Container elements are walked in place, and so are the properties that
+    have a RegisterPropertyReference (SerializationPlan.hpp) or already hand out the member (bind_as_ptr, as_reference_wrapper,
+    shared_ptr). Any other property on the way is copied out, patched and set back, so register the big containers that
+    paths go through (e.g. /circles/3/radius) and the cost follows the size of the patch, not the size of the object.
+
+    Reflected properties always exist, so they cannot be removed: remove only works on container elements and entries,
+    and a null member of a merge patch resets the property to a value initialized one (0, "", empty containers, and the
+    same for every property of an object without a registered default constructor).
+    Replacing an object overlays the members given, like loading does.
+    A patch stops at the first operation that fails, the operations before it stay applied.
+ */
+
+namespace JSON
+{
+    // *********************************************************
+    // *Where a JSON Pointer ends up inside the object, filled in by Patcher while it walks the path
+    // *********************************************************
+    struct PatchSlot
+    {
+        enum class Kind
+        {
+            Root,           // The empty pointer, the object itself
+            Property,       // property of object
+            Element,        // sequential[index]
+            Entry,          // The index-th entry of associative
+            Value           // Copy of the key or value of an entry, written back into the container by Patcher
+        };
+
+        Kind kind = Kind::Root;
+        instance* object = nullptr;
+        const PropertyPlan* property = nullptr;
+        variant_sequential_view* sequential = nullptr;
+        variant_associative_view* associative = nullptr;
+        variant* value = nullptr;
+        size_t index = 0;
+        // index is one past the last element, only add can use it
+        bool end = false;
+    };
+
+    class Patcher
+    {
+    public:
+        Patcher(instance root) : m_Root{ root.get_type().get_raw_type().is_wrapper() ? root.get_wrapped_instance() : root }
+        {
+            // A patch holds the whole container, merging it into the old one would keep the old values of its keys
+            m_Reader.SetReplaceAssociative(true);
+        }
+
+        // *********************************************************
+        // *RFC 6902 operations, every one returns false if the path does not resolve or the value does not fit
+        // *********************************************************
+        bool Add(const Pointer& path, Value& value)
+        {
+            return Visit(path, true, [&](PatchSlot& slot)
+                {
+                    switch (slot.kind)
+                    {
+                    case PatchSlot::Kind::Element:
+                        return InsertElement(*slot.sequential, slot.index, value);
+                    case PatchSlot::Kind::Entry:
+                        return InsertEntry(*slot.associative, value);
+                    default:
+                        return SetSlot(slot, value);
+                    }
+                });
+        }
+
+        bool Remove(const Pointer& path)
+        {
+            return Visit(path, true, [&](PatchSlot& slot)
+                {
+                    if (slot.end)
+                    {
+                        return false;
+                    }
+
+                    switch (slot.kind)
+                    {
+                    case PatchSlot::Kind::Element:
+                        if (!slot.sequential->is_dynamic())
+                        {
+                            return false;
+                        }
+                        slot.sequential->erase(slot.sequential->begin() + static_cast<int>(slot.index));
+                        return true;
+                    case PatchSlot::Kind::Entry:
+                        return slot.associative->erase(EntryAt(*slot.associative, slot.index).get_key().extract_wrapped_value()) > 0;
+                    default:
+                        // Properties and the object itself always exist
+                        return false;
+                    }
+                });
+        }
+
+        bool Replace(const Pointer& path, Value& value)
+        {
+            return Visit(path, true, [&](PatchSlot& slot)
+                {
+                    return !slot.end && SetSlot(slot, value);
+                });
+        }
+
+        // Remove from from, then add it at path, so from cannot be a property
+        bool Move(const Pointer& from, const Pointer& path)
+        {
+            // A value cannot be moved into itself
+            if (IsProperPrefix(from, path))
+            {
+                return false;
+            }
+            return Get(from) && Remove(from) && Add(path, m_Scratch);
+        }
+
+        bool Copy(const Pointer& from, const Pointer& path)
+        {
+            return Get(from) && Add(path, m_Scratch);
+        }
+
+        // The value at path written out as JSON has to equal value, numbers compare by value so 1 equals 1.0
+        bool Test(const Pointer& path, const Value& value)
+        {
+            return Get(path) && m_Scratch == value;
+        }
+
+        // Writes the value at path into GetScratch(), valid until the next operation
+        bool Get(const Pointer& path)
+        {
+            return Visit(path, false, [&](PatchSlot& slot)
+                {
+                    return !slot.end && WriteSlot(slot);
+                });
+        }
+
+        Document& GetScratch()
+        {
+            return m_Scratch;
+        }
+
+        // One {"op": ..., "path": ...} object of a JSON Patch
+        bool Apply(Value& operation)
+        {
+            if (!operation.IsObject())
+            {
+                return false;
+            }
+
+            const Value::MemberIterator op = operation.FindMember("op");
+            const Value::MemberIterator path = operation.FindMember("path");
+            if (op == operation.MemberEnd() || path == operation.MemberEnd() || !op->value.IsString() || !path->value.IsString())
+            {
+                return false;
+            }
+
+            const Pointer pathPointer{ path->value.GetString(), path->value.GetStringLength() };
+            if (!pathPointer.IsValid())
+            {
+                return false;
+            }
+
+            const char* name = op->value.GetString();
+            const Value::MemberIterator value = operation.FindMember("value");
+            const Value::MemberIterator from = operation.FindMember("from");
+            const bool hasValue = value != operation.MemberEnd();
+            const bool hasFrom = from != operation.MemberEnd() && from->value.IsString();
+
+            if (std::strcmp(name, "add") == 0)
+                return hasValue && Add(pathPointer, value->value);
+            if (std::strcmp(name, "remove") == 0)
+                return Remove(pathPointer);
+            if (std::strcmp(name, "replace") == 0)
+                return hasValue && Replace(pathPointer, value->value);
+            if (std::strcmp(name, "test") == 0)
+                return hasValue && Test(pathPointer, value->value);
+
+            if (!hasFrom)
+            {
+                return false;
+            }
+            const Pointer fromPointer{ from->value.GetString(), from->value.GetStringLength() };
+            if (!fromPointer.IsValid())
+            {
+                return false;
+            }
+
+            if (std::strcmp(name, "move") == 0)
+                return Move(fromPointer, pathPointer);
+            if (std::strcmp(name, "copy") == 0)
+                return Copy(fromPointer, pathPointer);
+            return false;
+        }
+
+        // A JSON Patch document, an array of operations applied in order, the offset of a failure is the operation index
+        SerializationResult ApplyPatch(Value& patch)
+        {
+            if (!patch.IsArray())
+            {
+                return ReportError(ErrorCode::UnexpectedLayout, "JSON Patch has to be an array");
+            }
+
+            for (SizeType i = 0; i < patch.Size(); ++i)
+            {
+                if (!Apply(patch[i]))
+                {
+                    const Value::ConstMemberIterator operation = patch[i].IsObject() ? patch[i].FindMember("op") : patch[i].MemberEnd();
+                    const bool hasName = patch[i].IsObject() && operation != patch[i].MemberEnd() && operation->value.IsString();
+                    return ReportError(ErrorCode::PatchFailed, hasName ? std::string_view(operation->value.GetString(), operation->value.GetStringLength()) : std::string_view(), i);
+                }
+            }
+            return SerializationResult{};
+        }
+
+        // *********************************************************
+        // *RFC 7386, the members of patch are merged into the object, objects recursively, everything else replaced
+        // *********************************************************
+        bool ApplyMergePatch(Value& patch)
+        {
+            return MergeObject(m_Root, patch);
+        }
+
+    private:
+        // *********************************************************
+        // *Path walk, action gets the slot the last token names
+        // *modifies tells if every property/entry on the way has to be set back after action
+        // *********************************************************
+        template <typename Action>
+        bool Visit(const Pointer& path, bool modifies, Action&& action)
+        {
+            if (!path.IsValid() || !m_Root.is_valid())
+            {
+                return false;
+            }
+
+            if (path.GetTokenCount() == 0)
+            {
+                PatchSlot slot;
+                slot.kind = PatchSlot::Kind::Root;
+                slot.object = &m_Root;
+                return action(slot);
+            }
+            return VisitObject(m_Root, path.GetTokens(), path.GetTokenCount(), modifies, action);
+        }
+
+        template <typename Action>
+        bool VisitObject(instance object, const Pointer::Token* tokens, size_t tokenCount, bool modifies, Action& action)
+        {
+            const TypePlan& plan = GetTypePlan(object.get_derived_type());
+            const PropertyPlan* propertyPlan = plan.FindProperty(tokens->name, tokens->length);
+            // NO_SERIALIZE properties are not part of the document, so no path leads to them
+            if (propertyPlan == nullptr || propertyPlan->noSerialize)
+            {
+                return false;
+            }
+
+            if (tokenCount == 1)
+            {
+                PatchSlot slot;
+                slot.kind = PatchSlot::Kind::Property;
+                slot.object = &object;
+                slot.property = propertyPlan;
+                return action(slot);
+            }
+
+            bool isCopy = true;
+            variant value = GetPropertyValue(object, *propertyPlan, isCopy);
+            if (!value || !VisitValue(value, tokens + 1, tokenCount - 1, modifies, action))
+            {
+                return false;
+            }
+            return !modifies || !isCopy || propertyPlan->prop.set_value(object, value);
+        }
+
+        // The property inside object when it can be reached in place, otherwise a copy (isCopy) that has to be set back after a change
+        static variant GetPropertyValue(const instance& object, const PropertyPlan& propertyPlan, bool& isCopy)
+        {
+            if (propertyPlan.inPlace != nullptr)
+            {
+                variant value = propertyPlan.inPlace(object);
+                if (value)
+                {
+                    isCopy = false;
+                    return value;
+                }
+            }
+
+            // Pointers and wrappers (bind_as_ptr, as_reference_wrapper, shared_ptr) lead to the member or object itself
+            const type propertyType = propertyPlan.prop.get_type();
+            isCopy = !propertyType.is_pointer() && !propertyType.is_wrapper();
+            return propertyPlan.prop.get_value(object);
+        }
+
+        // value is a property value, a reference to a container element, or a copy of an entry key/value
+        template <typename Action>
+        bool VisitValue(variant& value, const Pointer::Token* tokens, size_t tokenCount, bool modifies, Action& action)
+        {
+            if (value.is_sequential_container())
+            {
+                variant_sequential_view view = value.create_sequential_view();
+                PatchSlot slot;
+                if (!ParseIndex(*tokens, view.get_size(), slot))
+                {
+                    return false;
+                }
+
+                if (tokenCount == 1)
+                {
+                    slot.kind = PatchSlot::Kind::Element;
+                    slot.sequential = &view;
+                    return action(slot);
+                }
+
+                // Elements come back as std::reference_wrapper, whatever is done to element is done inside the container
+                variant element = view.get_value(slot.index);
+                return !slot.end && VisitValue(element, tokens + 1, tokenCount - 1, modifies, action);
+            }
+
+            if (value.is_associative_container())
+            {
+                return VisitEntry(value.create_associative_view(), tokens, tokenCount, modifies, action);
+            }
+
+            // Objects, also behind a wrapper (std::reference_wrapper of an element, pointers, shared_ptr)
+            const instance wrapped{ value };
+            instance object = wrapped.get_type().get_raw_type().is_wrapper() ? wrapped.get_wrapped_instance() : wrapped;
+            if (!object.is_valid() || object.get_derived_type().get_properties().empty())
+            {
+                return false;
+            }
+            return VisitObject(object, tokens, tokenCount, modifies, action);
+        }
+
+        // Keys cannot be changed in place, the entry is copied out, patched, and put back under its (maybe new) key
+        template <typename Action>
+        bool VisitEntry(variant_associative_view view, const Pointer::Token* tokens, size_t tokenCount, bool modifies, Action& action)
+        {
+            PatchSlot slot;
+            if (!ParseIndex(*tokens, view.get_size(), slot))
+            {
+                return false;
+            }
+
+            if (tokenCount == 1)
+            {
+                slot.kind = PatchSlot::Kind::Entry;
+                slot.associative = &view;
+                return action(slot);
+            }
+            if (slot.end)
+            {
+                return false;
+            }
+
+            const bool keyOnly = view.is_key_only_type();
+            const variant_associative_view::const_iterator entry = EntryAt(view, slot.index);
+            const variant oldKey = entry.get_key().extract_wrapped_value();
+            variant key = oldKey;
+            variant entryValue = keyOnly ? variant() : entry.get_value().extract_wrapped_value();
+
+            // Key only entries are their key, the others pick the key or the value
+            variant* part = &key;
+            if (!keyOnly)
+            {
+                const std::string name{ tokens[1].name, tokens[1].length };
+                if (name == "value")
+                    part = &entryValue;
+                else if (name != "key")
+                    return false;
+                ++tokens;
+                --tokenCount;
+            }
+
+            bool isApplied = false;
+            if (tokenCount == 1)
+            {
+                PatchSlot valueSlot;
+                valueSlot.kind = PatchSlot::Kind::Value;
+                valueSlot.value = part;
+                isApplied = action(valueSlot);
+            }
+            else
+            {
+                isApplied = VisitValue(*part, tokens + 1, tokenCount - 1, modifies, action);
+            }
+
+            if (!isApplied || !modifies)
+            {
+                return isApplied;
+            }
+
+            view.erase(oldKey);
+            return keyOnly ? view.insert(key).second : view.insert(key, entryValue).second;
+        }
+
+        // "-" or a number up to size, index == size sets end
+        static bool ParseIndex(const Pointer::Token& token, size_t size, PatchSlot& slot)
+        {
+            if (token.length == 1 && token.name[0] == '-')
+            {
+                slot.index = size;
+            }
+            else if (token.index != kPointerInvalidIndex && token.index <= size)
+            {
+                slot.index = token.index;
+            }
+            else
+            {
+                return false;
+            }
+            slot.end = slot.index == size;
+            return true;
+        }
+
+        static variant_associative_view::const_iterator EntryAt(const variant_associative_view& view, size_t index)
+        {
+            variant_associative_view::const_iterator entry = view.begin();
+            entry += static_cast<int>(index);
+            return entry;
+        }
+
+        static bool IsProperPrefix(const Pointer& prefix, const Pointer& path)
+        {
+            if (prefix.GetTokenCount() >= path.GetTokenCount())
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < prefix.GetTokenCount(); ++i)
+            {
+                const Pointer::Token& left = prefix.GetTokens()[i];
+                const Pointer::Token& right = path.GetTokens()[i];
+                if (left.length != right.length || std::memcmp(left.name, right.name, left.length) != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // *********************************************************
+        // *What the operations do to a slot
+        // *********************************************************
+        bool SetSlot(PatchSlot& slot, Value& value)
+        {
+            switch (slot.kind)
+            {
+            case PatchSlot::Kind::Root:
+                m_Reader.ReadFromJsonRecursively(*slot.object, value);
+                return value.IsObject();
+            case PatchSlot::Kind::Property:
+                m_Reader.ReadProperty(*slot.object, *slot.property, value);
+                return true;
+            case PatchSlot::Kind::Element:
+                if (slot.end)
+                {
+                    return false;
+                }
+                m_Reader.ReadElement(*slot.sequential, slot.index, value);
+                return true;
+            case PatchSlot::Kind::Entry:
+                if (slot.end)
+                {
+                    return false;
+                }
+                slot.associative->erase(EntryAt(*slot.associative, slot.index).get_key().extract_wrapped_value());
+                return InsertEntry(*slot.associative, value);
+            case PatchSlot::Kind::Value:
+            default:
+            {
+                variant newValue = m_Reader.ReadValue(slot.value->get_type(), value);
+                if (!newValue || newValue.get_type() != slot.value->get_type())
+                {
+                    return false;
+                }
+                *slot.value = newValue;
+                return true;
+            }
+            }
+        }
+
+        // Inserts a default constructed element at index and reads value into it
+        bool InsertElement(variant_sequential_view& view, size_t index, Value& value)
+        {
+            if (!view.is_dynamic())
+            {
+                return false;
+            }
+
+            variant element = Reader::CreateValue(view.get_value_type());
+            if (!element)
+            {
+                // No registered constructor, let the container default construct one at the back and take a copy of it
+                const size_t size = view.get_size();
+                if (!view.set_size(size + 1))
+                {
+                    return false;
+                }
+                element = view.get_value(size).extract_wrapped_value();
+                view.set_size(size);
+            }
+
+            const variant_sequential_view::const_iterator position = view.insert(view.begin() + static_cast<int>(index), element);
+            if (position == view.end())
+            {
+                return false;
+            }
+            m_Reader.ReadElement(view, index, value);
+            return true;
+        }
+
+        // value is a {"key": ..., "value": ...} entry, or the key of a key only container, an entry with the same key is replaced
+        bool InsertEntry(variant_associative_view& view, Value& value)
+        {
+            if (view.is_key_only_type())
+            {
+                const variant key = m_Reader.ReadValue(view.get_key_type(), value);
+                if (!key || key.get_type() != view.get_key_type())
+                {
+                    return false;
+                }
+                // Already in the set is fine, add of an existing member replaces it
+                view.insert(key);
+                return true;
+            }
+
+            if (!value.IsObject())
+            {
+                return false;
+            }
+            const Value::MemberIterator keyMember = value.FindMember("key");
+            const Value::MemberIterator valueMember = value.FindMember("value");
+            if (keyMember == value.MemberEnd() || valueMember == value.MemberEnd())
+            {
+                return false;
+            }
+
+            const variant key = m_Reader.ReadValue(view.get_key_type(), keyMember->value);
+            const variant entryValue = m_Reader.ReadValue(view.get_value_type(), valueMember->value);
+            if (!key || !entryValue || key.get_type() != view.get_key_type() || entryValue.get_type() != view.get_value_type())
+            {
+                return false;
+            }
+
+            view.erase(key);
+            return view.insert(key, entryValue).second;
+        }
+
+        // Writes the value in slot as JSON and parses it into m_Scratch
+        bool WriteSlot(PatchSlot& slot)
+        {
+            m_Output.clear();
+            OutputStream stream{ m_Output, m_WriteBuffer, sizeof(m_WriteBuffer) };
+            rapidjson::Writer<OutputStream> writer{ stream };
+            CompactWriter ownWriter{ writer };
+
+            switch (slot.kind)
+            {
+            case PatchSlot::Kind::Root:
+                ownWriter.WriteToJSONRecursively(*slot.object);
+                break;
+            case PatchSlot::Kind::Property:
+                ownWriter.WritePropertyValue(*slot.property, slot.property->prop.get_value(*slot.object));
+                break;
+            case PatchSlot::Kind::Element:
+                ownWriter.WriteVariant(slot.sequential->get_value(slot.index).extract_wrapped_value());
+                break;
+            case PatchSlot::Kind::Entry:
+            {
+                const variant_associative_view::const_iterator entry = EntryAt(*slot.associative, slot.index);
+                if (slot.associative->is_key_only_type())
+                {
+                    ownWriter.WriteVariant(entry.get_key().extract_wrapped_value());
+                    break;
+                }
+                ownWriter.StartObject();
+                ownWriter.PutKey("key");
+                ownWriter.WriteVariant(entry.get_key().extract_wrapped_value());
+                ownWriter.PutKey("value");
+                ownWriter.WriteVariant(entry.get_value().extract_wrapped_value());
+                ownWriter.EndObject();
+                break;
+            }
+            case PatchSlot::Kind::Value:
+            default:
+                ownWriter.WriteVariant(*slot.value);
+                break;
+            }
+
+            stream.Flush();
+            return !m_Scratch.Parse(m_Output.data(), m_Output.size()).HasParseError();
+        }
+
+        bool MergeObject(instance rttrObject, Value& patch)
+        {
+            if (!patch.IsObject())
+            {
+                return false;
+            }
+
+            instance object = rttrObject.get_type().get_raw_type().is_wrapper() ? rttrObject.get_wrapped_instance() : rttrObject;
+            const TypePlan& plan = GetTypePlan(object.get_derived_type());
+            bool isMerged = true;
+
+            for (Value::MemberIterator member = patch.MemberBegin(); member != patch.MemberEnd(); ++member)
+            {
+                // Members that are not a property are skipped like Reader does
+                const PropertyPlan* propertyPlan = plan.FindProperty(member->name.GetString(), member->name.GetStringLength());
+                if (propertyPlan == nullptr || propertyPlan->noSerialize)
+                {
+                    continue;
+                }
+
+                if (member->value.IsNull())
+                {
+                    variant value = propertyPlan->prop.get_value(object);
+                    isMerged = value && ResetValue(value) && propertyPlan->prop.set_value(object, value) && isMerged;
+                }
+                else if (member->value.IsObject() && propertyPlan->kind == PropertyKind::Object && !propertyPlan->isWrapper)
+                {
+                    bool isCopy = true;
+                    variant value = GetPropertyValue(object, *propertyPlan, isCopy);
+                    isMerged = value && MergeObject(value, member->value) && (!isCopy || propertyPlan->prop.set_value(object, value)) && isMerged;
+                }
+                else
+                {
+                    m_Reader.ReadProperty(object, *propertyPlan, member->value);
+                }
+            }
+            return isMerged;
+        }
+
+        // value, held by value, set to what value initializing its type gives: 0, false, "", empty containers
+        // Types without a registered default constructor are reset property by property, false if some part cannot be reset
+        static bool ResetValue(variant& value)
+        {
+            const type valueType = value.get_type();
+            if (valueType.is_pointer() || valueType.is_wrapper())
+            {
+                return false;
+            }
+
+            const variant created = Reader::CreateValue(valueType);
+            if (created && created.get_type() == valueType)
+            {
+                value = created;
+                return true;
+            }
+
+            if (valueType == type::get<std::string>())
+            {
+                value = std::string();
+                return true;
+            }
+
+            if (valueType.is_arithmetic())
+            {
+                variant zero{ 0 };
+                if (!zero.convert(valueType))
+                {
+                    return false;
+                }
+                value = zero;
+                return true;
+            }
+
+            if (valueType.is_enumeration())
+            {
+                for (const variant& enumerator : valueType.get_enumeration().get_values())
+                {
+                    bool isConverted = false;
+                    if (enumerator.to_int64(&isConverted) == 0 && isConverted)
+                    {
+                        value = enumerator;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            if (value.is_sequential_container())
+            {
+                variant_sequential_view view = value.create_sequential_view();
+                if (view.is_dynamic())
+                {
+                    view.clear();
+                    return true;
+                }
+
+                // Fixed size, every element is reset instead
+                for (size_t index = 0; index < view.get_size(); ++index)
+                {
+                    variant element = view.get_value(index).extract_wrapped_value();
+                    if (!ResetValue(element) || !view.set_value(index, element))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            if (value.is_associative_container())
+            {
+                value.create_associative_view().clear();
+                return true;
+            }
+
+            if (valueType.get_properties().empty())
+            {
+                return false;
+            }
+
+            instance object{ value };
+            for (const property& prop : valueType.get_properties())
+            {
+                if (prop.is_readonly())
+                {
+                    continue;
+                }
+
+                variant member = prop.get_value(object);
+                if (!member || !ResetValue(member) || !prop.set_value(object, member))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        instance m_Root;
+        Reader m_Reader;
+        Document m_Scratch;
+        std::string m_Output;
+        char m_WriteBuffer[1024];
+    };
+
+    // *********************************************************
+    // *Exposed Patch Functions
+    // *********************************************************
+    // patch is a JSON Patch document, an array of operations
+    inline SerializationResult ApplyPatch(instance rttrObject, Value& patch)
+    {
+        Patcher patcher{ rttrObject };
+        return patcher.ApplyPatch(patch);
+    }
+
+    // json has to be null terminated and mutable, it is parsed in place
+    inline SerializationResult ApplyPatch(instance rttrObject, char* json)
+    {
+        Document document;
+        if (json == nullptr)
+        {
+            return ReportError(ErrorCode::EmptyBuffer);
+        }
+        if (document.ParseInsitu(json).HasParseError())
+        {
+            return ReportError(ErrorCode::ParseError, GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+        }
+        return ApplyPatch(rttrObject, document);
+    }
+
+    inline SerializationResult ApplyMergePatch(instance rttrObject, Value& patch)
+    {
+        Patcher patcher{ rttrObject };
+        return patcher.ApplyMergePatch(patch) ? SerializationResult{} : ReportError(ErrorCode::PatchFailed, "merge");
+    }
+
+    inline SerializationResult ApplyMergePatch(instance rttrObject, char* json)
+    {
+        Document document;
+        if (json == nullptr)
+        {
+            return ReportError(ErrorCode::EmptyBuffer);
+        }
+        if (document.ParseInsitu(json).HasParseError())
+        {
+            return ReportError(ErrorCode::ParseError, GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+        }
+        return ApplyMergePatch(rttrObject, document);
+    }
+}
+
+#endif
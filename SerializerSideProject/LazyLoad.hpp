@@ -0,0 +1,222 @@
+/******************************************************************************/
+/*!
+\file       LazyLoad.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _LAZY_LOAD_HPP_
+#define _LAZY_LOAD_HPP_
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "JsonPatch.hpp"
+
+/*  Lazy load, the file is parsed in place up front but the properties are only read into the object the first time they are asked for.
+    For objects of which a session only touches a few properties, the conversion of the rest never happens.
+
+    The handle keeps the file buffer and the Document alive until Release, that is the memory traded for the time.
+    The object has to outlive the handle, and is only up to date for the properties that have been materialized,
+    reading the other ones straight off the object gives whatever it held before the load.
+ */
+
+namespace JSON
+{
+    class LazyHandle
+    {
+    public:
+        LazyHandle(instance rttrObject) :
+            m_Object{ rttrObject.get_type().get_raw_type().is_wrapper() ? rttrObject.get_wrapped_instance() : rttrObject },
+            m_Plan{ &GetTypePlan(m_Object.get_derived_type()) },
+            m_Materialized(m_Plan->properties.size(), false)
+        {
+        }
+
+        // Not copyable, the Document points into the buffer
+        LazyHandle(const LazyHandle&) = delete;
+        LazyHandle& operator=(const LazyHandle&) = delete;
+
+        // Reads the file and parses it in place, no property is read yet
+        SerializationResult LoadFile(const std::filesystem::path& filePath)
+        {
+            if (!m_Buffer.ReadFile(filePath))
+            {
+                return ReportError(ErrorCode::FileNotFound, filePath.u8string());
+            }
+            return Parse();
+        }
+
+        // Same as LoadFile for json already in memory, json is copied into the handle
+        SerializationResult Load(const char* json, size_t size)
+        {
+            m_Buffer.Assign(json, size);
+            return Parse();
+        }
+
+        // Reads the property name into the object unless it has been already, false if the document does not have it
+        bool Materialize(const std::string& name)
+        {
+            const PropertyPlan* propertyPlan = m_Plan->FindProperty(name.data(), name.size());
+            if (propertyPlan == nullptr || propertyPlan->noSerialize || !m_IsLoaded)
+            {
+                return false;
+            }
+
+            const size_t index = static_cast<size_t>(propertyPlan - m_Plan->properties.data());
+            if (m_Materialized[index])
+            {
+                return true;
+            }
+
+            const Value::MemberIterator member = m_Document.FindMember(Value(StringRef(name.data(), static_cast<SizeType>(name.size()))));
+            if (member == m_Document.MemberEnd())
+            {
+                return false;
+            }
+
+            m_Reader.ReadProperty(m_Object, *propertyPlan, member->value);
+            m_Materialized[index] = true;
+            ++m_MaterializedCount;
+            return true;
+        }
+
+        // Reads a value nested inside a property (a JSON Pointer like /position/x) without the rest of the property
+        bool MaterializePath(const char* pointer)
+        {
+            if (!m_IsLoaded || m_MaterializedPaths.count(pointer) > 0)
+            {
+                return m_IsLoaded;
+            }
+
+            const Pointer path{ pointer };
+            // Already there with the whole property
+            if (path.IsValid() && path.GetTokenCount() > 0)
+            {
+                const Pointer::Token& token = path.GetTokens()[0];
+                const PropertyPlan* propertyPlan = m_Plan->FindProperty(token.name, token.length);
+                if (propertyPlan != nullptr && m_Materialized[static_cast<size_t>(propertyPlan - m_Plan->properties.data())])
+                {
+                    return true;
+                }
+            }
+
+            Value* value = path.IsValid() ? path.Get(m_Document) : nullptr;
+            if (value == nullptr || !Patcher{ m_Object }.Replace(path, *value))
+            {
+                return false;
+            }
+            m_MaterializedPaths.insert(pointer);
+            return true;
+        }
+
+        // The value of the property name, materialized first
+        variant Get(const std::string& name)
+        {
+            Materialize(name);
+            const PropertyPlan* propertyPlan = m_Plan->FindProperty(name.data(), name.size());
+            return propertyPlan != nullptr ? propertyPlan->prop.get_value(m_Object) : variant();
+        }
+
+        template <typename Type>
+        Type GetValue(const std::string& name)
+        {
+            const variant value = Get(name);
+            return value.is_type<Type>() ? value.get_value<Type>() : Type{};
+        }
+
+        // Reads every property that has not been read yet, the object is then the same as after FromJsonFormat
+        void MaterializeAll()
+        {
+            if (!m_IsLoaded || m_MaterializedCount == m_Materialized.size())
+            {
+                return;
+            }
+
+            for (Value::MemberIterator member = m_Document.MemberBegin(); member != m_Document.MemberEnd(); ++member)
+            {
+                const PropertyPlan* propertyPlan = m_Plan->FindProperty(member->name.GetString(), member->name.GetStringLength());
+                if (propertyPlan == nullptr)
+                {
+                    continue;
+                }
+
+                const size_t index = static_cast<size_t>(propertyPlan - m_Plan->properties.data());
+                if (!m_Materialized[index])
+                {
+                    m_Reader.ReadProperty(m_Object, *propertyPlan, member->value);
+                    m_Materialized[index] = true;
+                    ++m_MaterializedCount;
+                }
+            }
+        }
+
+        // Frees the buffer and the Document, properties that were not materialized stay as they are on the object
+        void Release()
+        {
+            m_Document.SetNull();
+            m_Document.GetAllocator().Clear();
+            m_Buffer = InsituBuffer{};
+            m_IsLoaded = false;
+        }
+
+        bool IsMaterialized(const std::string& name) const
+        {
+            const PropertyPlan* propertyPlan = m_Plan->FindProperty(name.data(), name.size());
+            return propertyPlan != nullptr && m_Materialized[static_cast<size_t>(propertyPlan - m_Plan->properties.data())];
+        }
+
+        size_t GetMaterializedCount() const
+        {
+            return m_MaterializedCount;
+        }
+
+        // Memory held for the properties still to come, the file buffer plus the values of the Document
+        size_t GetRetainedBytes()
+        {
+            return m_Buffer.GetSize() + m_Document.GetAllocator().Capacity();
+        }
+
+    private:
+        SerializationResult Parse()
+        {
+            m_IsLoaded = false;
+            std::fill(m_Materialized.begin(), m_Materialized.end(), false);
+            m_MaterializedCount = 0;
+            m_MaterializedPaths.clear();
+            // Parsing does not give back the pool of the previous document on its own
+            m_Document.SetNull();
+            m_Document.GetAllocator().Clear();
+
+            if (m_Buffer.Empty())
+            {
+                return ReportError(ErrorCode::EmptyBuffer);
+            }
+            if (m_Document.ParseInsitu(m_Buffer.GetData()).HasParseError())
+            {
+                return ReportError(ErrorCode::ParseError, GetParseError_En(m_Document.GetParseError()), m_Document.GetErrorOffset());
+            }
+            if (!m_Document.IsObject())
+            {
+                return ReportError(ErrorCode::UnexpectedLayout, "Root has to be an object");
+            }
+            m_IsLoaded = true;
+            return SerializationResult{};
+        }
+
+        instance m_Object;
+        const TypePlan* m_Plan = nullptr;
+        Reader m_Reader;
+        InsituBuffer m_Buffer;
+        Document m_Document;
+        std::vector<bool> m_Materialized;
+        size_t m_MaterializedCount = 0;
+        std::unordered_set<std::string> m_MaterializedPaths;
+        bool m_IsLoaded = false;
+    };
+}
+
+#endif
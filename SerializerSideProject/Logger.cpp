@@ -7,23 +7,87 @@
             written consent of DigiPen Institute of Technology is prohibited.
  */
  /******************************************************************************/
-#ifndef _LOGGER_HPP_
-#define _LOGGER_HPP_
-
 #include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
 #include <iostream>
 
 namespace Logger
 {
-    //Discard everything before reading & writing to the file
+    namespace
+    {
+        // How long the flush thread sleeps when the ring is empty, the longest a message waits to be written
+        constexpr std::chrono::milliseconds FLUSH_INTERVAL{ 5 };
+
+        // Microseconds since the epoch, the only clock work on the calling thread
+        int64_t now()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        // "YYYY-MM-DD HH:MM:SS" in local time into buffer, which has room for 20 characters
+        void formatSecond(int64_t second, char* buffer)
+        {
+            const time_t time = static_cast<time_t>(second);
+            std::tm localTime{};
+#ifdef _WIN32
+            localtime_s(&localTime, &time);
+#else
+            localtime_r(&time, &localTime);
+#endif
+            std::strftime(buffer, 20, "%Y-%m-%d %H:%M:%S", &localTime);
+        }
+
+        const char* getLabel(ErrorType type)
+        {
+            switch (type)
+            {
+            case ErrorType::MESSAGES:
+                return "[Message] ";
+            case ErrorType::WARNING:
+                return "[Warning] ";
+            case ErrorType::ERROR:
+                return "[Error] ";
+            default:
+                return "[Undefined ErrorType] ";
+            }
+        }
+    }
+
+    // *********************************************************
+    // *FileWriter
+    // *********************************************************
+    // Appends to whatever the file already holds, the folder is made if it is not there
     FileWriter::FileWriter(const char* file) :
-        _fileName{ file }, _fileHandle{ _fileName, std::ios_base::trunc | std::ios_base::out }
+        _fileName{ file }
     {
+        const std::filesystem::path filePath{ _fileName };
+        std::error_code error;
+        if (filePath.has_parent_path())
+        {
+            std::filesystem::create_directories(filePath.parent_path(), error);
+        }
+
+#ifdef _WIN32
+        _wfopen_s(&_fileHandle, filePath.c_str(), L"ab");
+#else
+        _fileHandle = std::fopen(filePath.c_str(), "ab");
+#endif
+        if (_fileHandle == nullptr)
+        {
+            std::cerr << "Unable to open " << _fileName << " for logging!" << std::endl;
+        }
     }
 
     FileWriter::~FileWriter()
     {
-        //_fileHandle.close();
+        if (_fileHandle != nullptr)
+        {
+            std::fclose(_fileHandle);
+        }
     }
 
     std::filesystem::path FileWriter::getFileName() const
@@ -31,77 +95,249 @@ namespace Logger
         return _fileName;
     }
 
-    void FileWriter::writeLine(const std::string& content)
+    bool FileWriter::writeLine(std::string_view content)
     {
-        //std::fstream file{ _fileName, std::ios_base::out };
-        if (_fileHandle.is_open())
+        return _fileHandle != nullptr && std::fwrite(content.data(), 1, content.size(), _fileHandle) == content.size();
+    }
+
+    void FileWriter::flush()
+    {
+        if (_fileHandle != nullptr)
         {
-            //_fileHandle.write(content.c_str(), content.size());
-            _fileHandle << content.c_str();
-            _fileHandle.close();
+            std::fflush(_fileHandle);
         }
     }
 
-    const std::string FileWriter::readFile()
+    // Reads the file through its own handle, the append handle is left where it is
+    const std::string FileWriter::readFile() const
     {
-        std::stringstream ss;
-        if (_fileHandle.is_open())
+        std::string content;
+        std::FILE* file = nullptr;
+#ifdef _WIN32
+        _wfopen_s(&file, std::filesystem::path{ _fileName }.c_str(), L"rb");
+#else
+        file = std::fopen(_fileName.c_str(), "rb");
+#endif
+        if (file == nullptr)
         {
-            //Copy everything from file to ss
-            std::copy(std::istreambuf_iterator<char>(_fileHandle), std::istreambuf_iterator<char>(), std::ostreambuf_iterator<char>(ss));
+            return content;
         }
-        else
+
+        char buffer[4096];
+        size_t readSize = 0;
+        while ((readSize = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
         {
-            _fileHandle.open(_fileName, std::ios_base::in);
-            std::copy(std::istreambuf_iterator<char>(_fileHandle), std::istreambuf_iterator<char>(), std::ostreambuf_iterator<char>(ss));
-            _fileHandle.close();
+            content.append(buffer, readSize);
         }
-        return ss.str();
+        std::fclose(file);
+        return content;
     }
 
-    Logger::Logger(const char* logFilename) : FileWriter(logFilename)
+    // *********************************************************
+    // *Logger
+    // *********************************************************
+    Logger::Logger(const char* logFilename, size_t capacity) :
+        _file{ logFilename }, _ring{ std::make_unique<Entry[]>(capacity) }, _mask{ capacity - 1 }
     {
+        // Position & _mask only finds the slot for a power of 2
+        if (capacity < 2 || (capacity & _mask) != 0)
+        {
+            std::cerr << "Logger capacity has to be a power of 2, using " << DEFAULT_CAPACITY << std::endl;
+            _ring = std::make_unique<Entry[]>(DEFAULT_CAPACITY);
+            _mask = DEFAULT_CAPACITY - 1;
+        }
+
+        for (size_t i = 0; i <= _mask; ++i)
+        {
+            _ring[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        _thread = std::thread{ &Logger::flushThread, this };
     }
 
+    Logger::~Logger()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            _isRunning.store(false, std::memory_order_release);
+        }
+        _wakeUp.notify_one();
+        _thread.join();
+    }
+
+    // Current local time, formatted on the calling thread
     const std::string Logger::logCurrentDateTime()
     {
-        std::chrono::system_clock::time_point tp = std::chrono::system_clock::now();
-        time_t time = std::chrono::system_clock::to_time_t(tp);
-        char timeBuffer[40];
-        ctime_s(timeBuffer, sizeof(timeBuffer), &time);
+        char timeBuffer[20];
+        formatSecond(now() / 1000000, timeBuffer);
         return timeBuffer;
-    };
+    }
 
     void Logger::readLogs(ErrorType type) const
     {
         //Only shows the most recent
-        std::cout << _MapofLogs.at(type) << std::endl;
+        std::lock_guard<std::mutex> lock{ _mutex };
+        const auto found = _MapofLogs.find(type);
+        std::cout << (found != _MapofLogs.end() ? found->second : std::string()) << std::endl;
     }
 
-    void Logger::logError(const std::string& message, ErrorType type)
+    // Claims the slot at the enqueue position with one compare exchange, a full ring returns straight away
+    bool Logger::logError(std::string_view message, ErrorType type)
     {
-        std::string finalMsg;
+        size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+        Entry* entry = nullptr;
+        while (true)
+        {
+            entry = &_ring[position & _mask];
+            const size_t sequence = entry->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0)
+            {
+                if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The flush thread has not freed this slot yet, the ring is full
+                _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                position = _enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
 
-        switch (type)
+        entry->timestamp = now();
+        entry->type = type;
+        entry->length = static_cast<uint32_t>(std::min(message.size(), MESSAGE_SIZE));
+        std::memcpy(entry->message, message.data(), entry->length);
+        // Hands the slot to the flush thread
+        entry->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    void Logger::flush()
+    {
+        std::unique_lock<std::mutex> lock{ _mutex };
+        const size_t target = _enqueuePosition.load(std::memory_order_acquire);
+        if (_writtenPosition < target)
         {
-        case ErrorType::MESSAGES:
-            finalMsg += "[Message] ";
-            break;
-        case ErrorType::WARNING:
-            finalMsg += "[Warning] ";
-            break;
-        case ErrorType::ERROR:
-            finalMsg += "[Error] ";
-            break;
-        default:
-            finalMsg += "[Undefined ErrorType] ";
-            break;
+            _flushRequest = std::max(_flushRequest, target);
+            _wakeUp.notify_one();
+            _flushed.wait(lock, [this, target]() { return _writtenPosition >= target; });
         }
+        // What the thread wrote before anyone asked for a flush can still be in the FILE buffer
+        _file.flush();
+    }
 
-        finalMsg += message + " on " + logCurrentDateTime() + "\n";
-        writeLine(finalMsg);
-        _MapofLogs.insert(std::pair<ErrorType, std::string>(type, message));
+    size_t Logger::getDroppedCount() const
+    {
+        return _droppedCount.load(std::memory_order_relaxed);
     }
-}
 
-#endif
\ No newline at end of file
+    std::filesystem::path Logger::getFileName() const
+    {
+        return _file.getFileName();
+    }
+
+    // The date part only changes once a second, so localtime runs once per second and not once per entry
+    void Logger::formatEntry(const Entry& entry, std::string& line, int64_t& cachedSecond, char* cachedDate)
+    {
+        const int64_t second = entry.timestamp / 1000000;
+        if (second != cachedSecond)
+        {
+            formatSecond(second, cachedDate);
+            cachedSecond = second;
+        }
+
+        char milliseconds[8];
+        std::snprintf(milliseconds, sizeof(milliseconds), ".%03d\n", static_cast<int>(entry.timestamp / 1000 % 1000));
+        line += getLabel(entry.type);
+        line.append(entry.message, entry.length);
+        line += " on ";
+        line += cachedDate;
+        line += milliseconds;
+    }
+
+    void Logger::flushThread()
+    {
+        std::string batch;
+        int64_t cachedSecond = -1;
+        char cachedDate[20] = {};
+        std::string lastMessages[3];
+        bool hasLastMessage[3] = {};
+
+        while (true)
+        {
+            // Everything the producers have handed over, one write for the lot
+            // Only this thread dequeues, so the dequeue position needs no compare exchange
+            size_t position = _dequeuePosition.load(std::memory_order_relaxed);
+            const size_t start = position;
+            while (true)
+            {
+                Entry& entry = _ring[position & _mask];
+                if (entry.sequence.load(std::memory_order_acquire) != position + 1)
+                {
+                    break;
+                }
+
+                formatEntry(entry, batch, cachedSecond, cachedDate);
+                const size_t typeIndex = static_cast<size_t>(entry.type);
+                if (typeIndex < 3)
+                {
+                    lastMessages[typeIndex].assign(entry.message, entry.length);
+                    hasLastMessage[typeIndex] = true;
+                }
+                // Frees the slot for the producers one lap later
+                entry.sequence.store(position + _mask + 1, std::memory_order_release);
+                ++position;
+            }
+            _dequeuePosition.store(position, std::memory_order_relaxed);
+
+            if (!batch.empty())
+            {
+                _file.writeLine(batch);
+                batch.clear();
+            }
+
+            std::unique_lock<std::mutex> lock{ _mutex };
+            for (size_t i = 0; i < 3; ++i)
+            {
+                if (hasLastMessage[i])
+                {
+                    _MapofLogs[static_cast<ErrorType>(i)] = std::move(lastMessages[i]);
+                    hasLastMessage[i] = false;
+                }
+            }
+
+            _writtenPosition = position;
+            if (_flushRequest > 0 && _writtenPosition >= _flushRequest)
+            {
+                _file.flush();
+                _flushRequest = 0;
+                _flushed.notify_all();
+            }
+
+            if (position == start)
+            {
+                if (!_isRunning.load(std::memory_order_acquire))
+                {
+                    break;
+                }
+                _wakeUp.wait_for(lock, FLUSH_INTERVAL, [this]()
+                    {
+                        return _flushRequest > _writtenPosition || !_isRunning.load(std::memory_order_acquire);
+                    });
+            }
+        }
+        _file.flush();
+    }
+
+    Logger& getAssertionLogger()
+    {
+        static Logger logger{ "log/Assertion.log" };
+        return logger;
+    }
+}
@@ -11,10 +11,23 @@
 #ifndef _LOGGER_H_
 #define _LOGGER_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
 #include <filesystem>
-#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 
+/*  Asynchronous logger, logError only copies the message and a binary timestamp into a slot of a lock free ring buffer
+    (bounded multi producer queue, one sequence number per slot), a background thread formats the entries and appends
+    them to the file. A full ring drops the entry instead of waiting, so logging never blocks the caller.
+ */
+
 namespace Logger
 {
     enum class ErrorType
@@ -24,35 +37,91 @@ namespace Logger
         ERROR = 2
     };
 
+    // Appends to the file, the handle stays open until the writer is destroyed
     class FileWriter
     {
     public:
         FileWriter(const char* file);
         ~FileWriter();
 
+        FileWriter(const FileWriter&) = delete;
+        FileWriter& operator=(const FileWriter&) = delete;
+
         std::filesystem::path getFileName() const;
-        void writeLine(const std::string& content);
-        const std::string readFile();
+        bool writeLine(std::string_view content);
+        void flush();
+        const std::string readFile() const;
 
     private:
-        //std::filesystem::path path;
         std::string _fileName;
-        std::fstream _fileHandle;
+        std::FILE* _fileHandle = nullptr;
     };
 
-    class Logger : public FileWriter
+    class Logger
     {
     public:
-        Logger(const char* logFilename);
+        // Longer messages are cut, every slot has room for one message so enqueueing never allocates
+        static constexpr size_t MESSAGE_SIZE = 232;
+        // Slots in the ring, has to be a power of 2
+        static constexpr size_t DEFAULT_CAPACITY = 8192;
+
+        Logger(const char* logFilename, size_t capacity = DEFAULT_CAPACITY);
+        // Writes everything still in the ring before returning
+        ~Logger();
 
-        const std::string logCurrentDateTime();
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        static const std::string logCurrentDateTime();
+        // Most recent message of type that has been written
         void readLogs(ErrorType type) const;
 
-        void logError(const std::string& message, ErrorType type);
+        // Safe from any thread, false if the ring was full and the entry was dropped
+        bool logError(std::string_view message, ErrorType type);
+
+        // Blocks until everything logged before the call is in the file
+        void flush();
+
+        // Entries dropped because the ring was full
+        size_t getDroppedCount() const;
+        std::filesystem::path getFileName() const;
 
     private:
+        struct alignas(64) Entry
+        {
+            // Slot is free for the producer at position sequence, filled for the consumer at sequence - 1
+            std::atomic<size_t> sequence;
+            int64_t timestamp;
+            ErrorType type;
+            uint32_t length;
+            char message[MESSAGE_SIZE];
+        };
+
+        void flushThread();
+        static void formatEntry(const Entry& entry, std::string& line, int64_t& cachedSecond, char* cachedDate);
+
+        FileWriter _file;
+        std::unique_ptr<Entry[]> _ring;
+        size_t _mask;
+
+        // Producers and the flush thread each get their own cache line
+        alignas(64) std::atomic<size_t> _enqueuePosition{ 0 };
+        alignas(64) std::atomic<size_t> _dequeuePosition{ 0 };
+        alignas(64) std::atomic<size_t> _droppedCount{ 0 };
+
+        std::atomic<bool> _isRunning{ true };
+        // Only used to wake the flush thread for flush() and shutdown, producers never lock it
+        mutable std::mutex _mutex;
+        std::condition_variable _wakeUp;
+        std::condition_variable _flushed;
+        size_t _flushRequest = 0;
+        size_t _writtenPosition = 0;
         std::unordered_map<ErrorType, std::string> _MapofLogs;
+        std::thread _thread;
     };
+
+    // Process wide logger the asserts go through, made on first use
+    Logger& getAssertionLogger();
 }
 
 #endif
@@ -0,0 +1,61 @@
+/******************************************************************************/
+/*!
+\file       MemberList.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _MEMBER_LIST_HPP_
+#define _MEMBER_LIST_HPP_
+
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+/*  Compile time description of the members of a type, for small hot types (point2d, Vector3) that are saved and loaded
+    so often that boxing every field into an rttr::variant shows up.
+
+    Opt in by specializing JSON::MemberList with a constexpr tuple of JSON::MakeMember(name, member pointer):
+    template <>
+    struct JSON::MemberList<point2d>
+    {
+        static constexpr auto members = std::make_tuple(JSON::MakeMember("x", &point2d::x), JSON::MakeMember("y", &point2d::y));
+    };
+
+    The type still has to be registered with RTTR, with the same properties, then JSON::RegisterMemberList<point2d>()
+    (MemberListSerializer.hpp) hooks the generated read/write functions into the RTTR walk.
+    Members can be numbers, std::string, registered enums or types that have a member list of their own.
+ */
+
+namespace JSON
+{
+    template <typename Class, typename Type>
+    struct Member
+    {
+        using ValueType = Type;
+
+        // Same name as the RTTR property
+        std::string_view name;
+        Type Class::* pointer;
+    };
+
+    template <typename Class, typename Type>
+    constexpr Member<Class, Type> MakeMember(std::string_view name, Type Class::* pointer)
+    {
+        return Member<Class, Type>{ name, pointer };
+    }
+
+    // Specialize with a static constexpr members tuple, see above
+    template <typename Type, typename = void>
+    struct MemberList {};
+
+    template <typename Type, typename = void>
+    struct has_member_list : std::false_type {};
+
+    template <typename Type>
+    struct has_member_list<Type, std::void_t<decltype(MemberList<Type>::members)>> : std::true_type {};
+}
+
+#endif
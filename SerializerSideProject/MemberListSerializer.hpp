@@ -0,0 +1,287 @@
+/******************************************************************************/
+/*!
+\file       MemberListSerializer.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _MEMBER_LIST_SERIALIZER_HPP_
+#define _MEMBER_LIST_SERIALIZER_HPP_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "BinarySerialization.hpp"
+#include "MemberList.hpp"
+
+/*  Read/write functions generated from a MemberList, every member is read and written as its real type through a fold
+    over the tuple, no rttr::variant, no property lookup and no dispatch table in between.
+
+    JSON::RegisterMemberList<Type>() checks the member list against the RTTR properties of Type and puts the functions
+    into the TypePlan of Type, from then on the Writer, Reader, SaxReader and the binary format use them for every Type
+    they come across, as a property, an array element or the root object. The output is the same as the RTTR walk's.
+    Call it at start up after the RTTR registration, a plan already built for Type is updated, and register member types
+    with a member list of their own before the types that hold them.
+ */
+
+namespace JSON
+{
+    template <typename Type>
+    using MemberTuple = std::remove_const_t<decltype(MemberList<Type>::members)>;
+
+    template <typename Type>
+    using MemberIndices = std::make_index_sequence<std::tuple_size_v<MemberTuple<Type>>>;
+
+    template <typename Type>
+    constexpr bool IsMemberListValue()
+    {
+        return std::is_arithmetic_v<Type> || std::is_enum_v<Type> || std::is_same_v<Type, std::string> || has_member_list<Type>::value;
+    }
+
+    // Registered entry of Type, RegisterMemberList made sure the member types have one before Type got its own
+    template <typename Type>
+    const MemberListSerializer& GetRegisteredMemberList()
+    {
+        static const MemberListSerializer& memberList = *FindMemberList(type::get<Type>());
+        return memberList;
+    }
+
+    // *********************************************************
+    // *Writing
+    // *********************************************************
+    template <typename OutputHandler, typename Type>
+    void WriteMembers(OutputHandler& handler, const Type& object);
+
+    template <typename OutputHandler, typename Type>
+    void WriteMemberValue(OutputHandler& handler, const Type& value)
+    {
+        static_assert(IsMemberListValue<Type>(), "Member lists can only hold numbers, std::string, enums and types with a member list");
+
+        if constexpr (has_member_list<Type>::value)
+        {
+            WriteMembers(handler, value);
+        }
+        else if constexpr (std::is_same_v<Type, std::string>)
+        {
+            handler.String(value.data(), static_cast<SizeType>(value.size()));
+        }
+        else if constexpr (std::is_enum_v<Type>)
+        {
+            // Same as the RTTR walk, the name if the value is registered, else the underlying number
+            const string_view name = type::get<Type>().get_enumeration().value_to_name(value);
+            if (!name.empty())
+                handler.String(name.data(), static_cast<SizeType>(name.size()));
+            else
+                handler.Uint64(static_cast<uint64_t>(value));
+        }
+        else
+        {
+            GenericWriter<OutputHandler>::WriteNumber(handler, value);
+        }
+    }
+
+    template <typename OutputHandler, typename Type, size_t... Index>
+    void WriteMemberValues(OutputHandler& handler, const Type& object, std::index_sequence<Index...>)
+    {
+        constexpr const MemberTuple<Type>& members = MemberList<Type>::members;
+
+        if constexpr (has_property_ids<OutputHandler>::value)
+        {
+            const uint32_t* propertyIds = GetRegisteredMemberList<Type>().propertyIds.data();
+            ((handler.PropertyId(propertyIds[Index]), WriteMemberValue(handler, object.*std::get<Index>(members).pointer)), ...);
+        }
+        else
+        {
+            ((handler.Key(std::get<Index>(members).name.data(), static_cast<SizeType>(std::get<Index>(members).name.size())),
+                WriteMemberValue(handler, object.*std::get<Index>(members).pointer)), ...);
+        }
+    }
+
+    template <typename OutputHandler, typename Type>
+    void WriteMembers(OutputHandler& handler, const Type& object)
+    {
+        handler.StartObject();
+        WriteMemberValues(handler, object, MemberIndices<Type>{});
+        handler.EndObject();
+    }
+
+    // *********************************************************
+    // *Reading, values that do not fit their member are skipped like the Reader does
+    // *********************************************************
+    template <typename Type>
+    void ReadMembers(const Value& jsonObject, Type& object);
+
+    template <typename Type>
+    void ReadMemberValue(const Value& jsonValue, Type& value)
+    {
+        static_assert(IsMemberListValue<Type>(), "Member lists can only hold numbers, std::string, enums and types with a member list");
+
+        if constexpr (has_member_list<Type>::value)
+        {
+            ReadMembers(jsonValue, value);
+        }
+        else if constexpr (std::is_enum_v<Type>)
+        {
+            const variant enumValue = Reader::ReadEnumerationValue(type::get<Type>(), jsonValue);
+            if (enumValue.is_type<Type>())
+                value = enumValue.get_value<Type>();
+        }
+        else if constexpr (std::is_arithmetic_v<Type>)
+        {
+            // Numbers that do not fit exactly (1.5 into an int) are truncated like Reader::ReadNumbers does,
+            // numbers out of the range of Type leave the member as it is
+            if (!Reader::ReadAtomicValue(jsonValue, value) && jsonValue.IsNumber() && Reader::IsInRange<Type>(jsonValue.GetDouble()))
+                value = static_cast<Type>(jsonValue.GetDouble());
+        }
+        else
+        {
+            Reader::ReadAtomicValue(jsonValue, value);
+        }
+    }
+
+    // Reads jsonValue into the member called name, false if Type has no such member
+    template <typename Type, size_t... Index>
+    bool ReadNamedMember(Type& object, std::string_view name, const Value& jsonValue, std::index_sequence<Index...>)
+    {
+        constexpr const MemberTuple<Type>& members = MemberList<Type>::members;
+        return ((std::get<Index>(members).name == name && (ReadMemberValue(jsonValue, object.*std::get<Index>(members).pointer), true)) || ...);
+    }
+
+    template <typename Type>
+    void ReadMembers(const Value& jsonObject, Type& object)
+    {
+        if (!jsonObject.IsObject())
+        {
+            return;
+        }
+
+        for (Value::ConstMemberIterator member = jsonObject.MemberBegin(); member != jsonObject.MemberEnd(); ++member)
+        {
+            ReadNamedMember(object, std::string_view(member->name.GetString(), member->name.GetStringLength()), member->value, MemberIndices<Type>{});
+        }
+    }
+
+    template <typename Type, size_t... Index>
+    void ReadIndexedMember(Type& object, uint32_t member, const Value& jsonValue, std::index_sequence<Index...>)
+    {
+        constexpr const MemberTuple<Type>& members = MemberList<Type>::members;
+        (void)((member == Index && (ReadMemberValue(jsonValue, object.*std::get<Index>(members).pointer), true)) || ...);
+    }
+
+    template <typename Type, size_t... Index>
+    void GetMemberObject(Type& object, uint32_t member, std::optional<instance>& result, std::index_sequence<Index...>)
+    {
+        constexpr const MemberTuple<Type>& members = MemberList<Type>::members;
+        const auto emplace = [&result](auto& value)
+        {
+            if constexpr (has_member_list<std::decay_t<decltype(value)>>::value)
+                result.emplace(value);
+        };
+        (void)((member == Index && (emplace(object.*std::get<Index>(members).pointer), true)) || ...);
+    }
+
+    // *********************************************************
+    // *Registration
+    // *********************************************************
+    template <typename Type, size_t... Index>
+    bool BuildMemberIds(MemberListSerializer& memberList, std::index_sequence<Index...>)
+    {
+        constexpr const MemberTuple<Type>& members = MemberList<Type>::members;
+        const array_range<property> properties = type::get<Type>().get_properties();
+        memberList.propertyIds.assign(sizeof...(Index), MemberListSerializer::NO_MEMBER);
+        memberList.propertyMembers.assign(properties.size(), MemberListSerializer::NO_MEMBER);
+
+        const auto findMember = [&](uint32_t index, std::string_view name, const type& valueType, bool hasMemberList)
+        {
+            uint32_t propertyIndex = 0;
+            for (const property& prop : properties)
+            {
+                if (std::string_view(prop.get_name().data(), prop.get_name().size()) == name && memberList.propertyMembers[propertyIndex] == MemberListSerializer::NO_MEMBER)
+                {
+                    // Exactly the RTTR property, so the output stays the same
+                    if (prop.get_type() != valueType || prop.get_metadata("NO_SERIALIZE") || (hasMemberList && FindMemberList(valueType) == nullptr))
+                    {
+                        return false;
+                    }
+                    memberList.propertyIds[index] = propertyIndex;
+                    memberList.propertyMembers[propertyIndex] = index;
+                    return true;
+                }
+                ++propertyIndex;
+            }
+            return false;
+        };
+
+        using Members = MemberTuple<Type>;
+        if (!(findMember(static_cast<uint32_t>(Index), std::get<Index>(members).name,
+            type::get<typename std::tuple_element_t<Index, Members>::ValueType>(),
+            has_member_list<typename std::tuple_element_t<Index, Members>::ValueType>::value) && ...))
+        {
+            return false;
+        }
+
+        // Every property the RTTR walk writes has to be in the list
+        size_t serializedCount = 0;
+        for (const property& prop : properties)
+        {
+            serializedCount += prop.get_metadata("NO_SERIALIZE") ? 0 : 1;
+        }
+        return serializedCount == sizeof...(Index);
+    }
+
+    // False if the member list does not match the RTTR properties of Type, Type then stays on the RTTR walk
+    // Not thread safe, register everything at start up before any threads serialize
+    template <typename Type>
+    bool RegisterMemberList()
+    {
+        static_assert(has_member_list<Type>::value, "Type needs a JSON::MemberList specialization");
+
+        MemberListSerializer memberList;
+        if (!BuildMemberIds<Type>(memberList, MemberIndices<Type>{}))
+        {
+            const string_view typeName = type::get<Type>().get_name();
+            ReportDiagnostic(ErrorCode::RegistrationMismatch, std::string_view(typeName.data(), typeName.size()));
+            return false;
+        }
+
+        memberList.address = [](const instance& object) -> void*
+        {
+            return object.try_convert<Type>();
+        };
+        memberList.writePretty = [](PrettyWriter<OutputStream>& handler, const void* object)
+        {
+            WriteMembers(handler, *static_cast<const Type*>(object));
+        };
+        memberList.writeCompact = [](rapidjson::Writer<OutputStream>& handler, const void* object)
+        {
+            WriteMembers(handler, *static_cast<const Type*>(object));
+        };
+        memberList.writeBinary = [](Binary::Encoder& handler, const void* object)
+        {
+            WriteMembers(handler, *static_cast<const Type*>(object));
+        };
+        memberList.read = [](void* object, const Value& jsonObject)
+        {
+            ReadMembers(jsonObject, *static_cast<Type*>(object));
+        };
+        memberList.readMember = [](void* object, uint32_t member, const Value& jsonValue)
+        {
+            ReadIndexedMember(*static_cast<Type*>(object), member, jsonValue, MemberIndices<Type>{});
+        };
+        memberList.memberObject = [](void* object, uint32_t member, std::optional<instance>& result)
+        {
+            GetMemberObject(*static_cast<Type*>(object), member, result, MemberIndices<Type>{});
+        };
+
+        GetMemberLists().insert_or_assign(type::get<Type>(), std::move(memberList));
+        RefreshTypePlans();
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,193 @@
+/******************************************************************************/
+/*!
+\file       ObjectGraph.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _OBJECT_GRAPH_HPP_
+#define _OBJECT_GRAPH_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Serialization.hpp"
+
+/*  Object graph format, every object behind a registered pointer (JSON::RegisterReference) is written once however
+    many pointers lead to it, and the pointers are written as {"$ref": id}. Shared materials, parent pointers and cycles
+    come back as the same object instead of one copy per pointer (or a walk that never ends).
+
+    {
+        "$root": { ...rttrObject, pointers as {"$ref": 0}... },
+        "$refs": [ { "$type": "material", "$value": { ... } }, ... ]
+    }
+
+    Loading makes every object in $refs first and then reads them, so a pointer can name an object that comes later.
+    Loaded objects are owned by std::shared_ptr, every load takes objects to keep the ones only raw pointers lead to alive.
+    Objects are saved and loaded as the type the pointer was registered with, a derived object behind a base pointer loses its own properties.
+    Only the Document reader and the JSON writers know about references, the SAX reader and the binary format do not.
+ */
+
+namespace JSON
+{
+    // *********************************************************
+    // *Object Graph Helper Functions
+    // *********************************************************
+    template <typename OutputHandler>
+    void WriteGraph(OutputHandler& handler, const instance& obj)
+    {
+        ReferenceTable references;
+        GenericWriter<OutputHandler> ownWriter{ handler };
+        ownWriter.SetReferences(&references);
+
+        ownWriter.StartObject();
+        ownWriter.PutKey("$root");
+        ownWriter.WriteToJSONRecursively(obj);
+
+        ownWriter.PutKey("$refs");
+        ownWriter.StartArray();
+        // The objects written here can point to new ones, which go to the end of the table
+        for (size_t id = 0; id < references.GetCount(); ++id)
+        {
+            ownWriter.StartObject();
+            ownWriter.PutKey("$type");
+            ownWriter.PutValue(references.GetObjectType(id).get_name().to_string());
+            ownWriter.PutKey("$value");
+            ownWriter.WriteToJSONRecursively(references.GetObject(id));
+            ownWriter.EndObject();
+        }
+        ownWriter.EndArray();
+        ownWriter.EndObject();
+    }
+
+    inline void WriteGraphToStream(OutputStream& stream, const instance& obj, JsonFormat format)
+    {
+        if (format == JsonFormat::Compact)
+        {
+            rapidjson::Writer<OutputStream> writer(stream);
+            WriteGraph(writer, obj);
+        }
+        else
+        {
+            PrettyWriter<OutputStream> writer(stream);
+            WriteGraph(writer, obj);
+        }
+    }
+
+    // Parses json in place into document, makes the objects of $refs and reads everything into them and rttrObject
+    inline SerializationResult ReadGraph(Document& document, char* json, instance rttrObject, std::vector<std::shared_ptr<void>>& objects)
+    {
+        if (json == nullptr || *json == '\0')
+        {
+            return ReportError(ErrorCode::EmptyBuffer);
+        }
+
+        if (document.ParseInsitu(json).HasParseError())
+        {
+            return ReportError(ErrorCode::ParseError, GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+        }
+
+        const Value::MemberIterator root = document.IsObject() ? document.FindMember("$root") : document.MemberEnd();
+        const Value::MemberIterator refs = document.IsObject() ? document.FindMember("$refs") : document.MemberEnd();
+        if (!document.IsObject() || root == document.MemberEnd() || refs == document.MemberEnd() || !refs->value.IsArray())
+        {
+            return ReportError(ErrorCode::UnexpectedLayout, "JSON is not an object graph, $root or $refs is missing");
+        }
+
+        // Every object exists before any is read, so pointers to objects further down (or to themselves) resolve
+        ReferenceTable references;
+        for (Value& entry : refs->value.GetArray())
+        {
+            const Value::MemberIterator typeName = entry.IsObject() ? entry.FindMember("$type") : entry.MemberEnd();
+            if (!entry.IsObject() || typeName == entry.MemberEnd() || !typeName->value.IsString())
+            {
+                return ReportError(ErrorCode::UnexpectedLayout, "Object graph entry has no $type");
+            }
+
+            const type objectType = type::get_by_name(string_view(typeName->value.GetString(), typeName->value.GetStringLength()));
+            const ReferenceType* reference = objectType.is_valid() ? FindReferencedObject(objectType) : nullptr;
+            if (reference == nullptr)
+            {
+                return ReportError(ErrorCode::RegistrationMismatch, std::string_view(typeName->value.GetString(), typeName->value.GetStringLength()));
+            }
+            references.Add(reference->create(), *reference);
+        }
+
+        Reader ownReader{ document };
+        ownReader.SetReferences(&references);
+        for (SizeType id = 0; id < refs->value.Size(); ++id)
+        {
+            const Value::MemberIterator value = refs->value[id].FindMember("$value");
+            if (value != refs->value[id].MemberEnd())
+            {
+                ownReader.ReadFromJsonRecursively(references.GetObject(id), value->value);
+            }
+        }
+        ownReader.ReadFromJsonRecursively(rttrObject, root->value);
+
+        objects = references.TakeObjects();
+        return SerializationResult{};
+    }
+
+    // *********************************************************
+    // *Exposed Object Graph Functions
+    // *********************************************************
+    inline std::string ToJsonGraph(const instance& obj, JsonFormat format = JsonFormat::Pretty)
+    {
+        if (!obj.is_valid())
+        {
+            ReportDiagnostic(ErrorCode::InvalidObject);
+            return std::string();
+        }
+
+        std::string json;
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        OutputStream stream{ json, writeBuffer, sizeof(writeBuffer) };
+        WriteGraphToStream(stream, obj, format);
+        stream.Flush();
+        return json;
+    }
+
+    inline SerializationResult SerializeGraphToFile(const std::filesystem::path& filePath, const instance& obj, JsonFormat format = JsonFormat::Pretty)
+    {
+        if (!obj.is_valid())
+        {
+            return ReportError(ErrorCode::InvalidObject);
+        }
+
+        FilePointer file = OpenFile(filePath, "wb");
+        if (!file)
+        {
+            return ReportError(ErrorCode::FileNotWritable, filePath.u8string());
+        }
+
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        OutputStream stream{ file.get(), writeBuffer, sizeof(writeBuffer) };
+        WriteGraphToStream(stream, obj, format);
+        stream.Flush();
+        return stream.Good() ? SerializationResult{} : ReportError(ErrorCode::FileWriteFailed, filePath.u8string());
+    }
+
+    // json has to be null terminated and mutable, it is parsed in place
+    // objects gets the loaded objects in $refs order, objects only raw pointers lead to are freed with it
+    inline SerializationResult FromJsonGraph(char* json, instance rttrObject, std::vector<std::shared_ptr<void>>& objects)
+    {
+        Document document;
+        return ReadGraph(document, json, rttrObject, objects);
+    }
+
+    inline SerializationResult DeserializeGraphFromFile(const std::filesystem::path& filePath, instance rttrObject, std::vector<std::shared_ptr<void>>& objects)
+    {
+        InsituBuffer buffer;
+        if (!buffer.ReadFile(filePath))
+        {
+            return ReportError(ErrorCode::FileNotFound, filePath.u8string());
+        }
+        return FromJsonGraph(buffer.GetData(), rttrObject, objects);
+    }
+}
+
+#endif
@@ -0,0 +1,411 @@
+/******************************************************************************/
+/*!
+\file       PartialLoad.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _PARTIAL_LOAD_HPP_
+#define _PARTIAL_LOAD_HPP_
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "JsonPatch.hpp"
+#include "rapidjson/stringbuffer.h"
+
+/*  Partial load, only the values at a list of JSON Pointers are read into the object, e.g. /position and /visible
+    out of every entity file while streaming a level in.
+
+    The file goes through rapidjson::Reader once. Subtrees that are not on the way to a selected pointer are skipped
+    token by token, nothing is built for them. A selected subtree is written out through a rapidjson::Writer as it
+    streams past, and parsing stops as soon as every selected pointer has been seen.
+    The captured subtrees are then put into the object with Patcher::Replace, so paths resolve exactly like JSON Patch paths do,
+    and the containers on the way are walked in place when their property has a RegisterPropertyReference, otherwise
+    /circles/3/position copies circles out of the object and back.
+    Containers on the way to a pointer (e.g. /circles/3/position) have to hold that element already, select the container to load it whole.
+ */
+
+namespace JSON
+{
+    // *********************************************************
+    // *rapidjson::Reader handler that keeps the JSON text of the selected subtrees and skips everything else
+    // *Pointers inside another selected pointer are loaded with it and are dropped up front
+    // *********************************************************
+    class PartialLoadHandler
+    {
+    public:
+        struct Selection
+        {
+            const Pointer* pointer = nullptr;
+            // Tokens of pointer that match the values currently open
+            size_t matched = 0;
+            bool isCaptured = false;
+            std::string json;
+        };
+
+        PartialLoadHandler(const std::vector<Pointer>& pointers)
+        {
+            for (size_t i = 0; i < pointers.size(); ++i)
+            {
+                bool isCovered = !pointers[i].IsValid();
+                for (size_t j = 0; j < pointers.size() && !isCovered; ++j)
+                {
+                    // Equal pointers only keep the first one
+                    isCovered = j != i && IsPrefix(pointers[j], pointers[i]) &&
+                        (pointers[j].GetTokenCount() < pointers[i].GetTokenCount() || j < i);
+                }
+
+                if (!isCovered)
+                {
+                    Selection selection;
+                    selection.pointer = &pointers[i];
+                    m_Selections.push_back(std::move(selection));
+                }
+            }
+        }
+
+        // Every selected pointer was found, parsing was stopped there on purpose
+        bool IsDone() const
+        {
+            return m_CapturedCount == m_Selections.size();
+        }
+
+        std::vector<Selection>& GetSelections()
+        {
+            return m_Selections;
+        }
+
+        // *********************************************************
+        // *rapidjson::Reader handler functions
+        // *********************************************************
+        bool Null()                             { return Scalar([&]() { m_Writer.Null(); }); }
+        bool Bool(bool value)                   { return Scalar([&]() { m_Writer.Bool(value); }); }
+        bool Int(int value)                     { return Scalar([&]() { m_Writer.Int(value); }); }
+        bool Uint(unsigned value)               { return Scalar([&]() { m_Writer.Uint(value); }); }
+        bool Int64(int64_t value)               { return Scalar([&]() { m_Writer.Int64(value); }); }
+        bool Uint64(uint64_t value)             { return Scalar([&]() { m_Writer.Uint64(value); }); }
+        bool Double(double value)               { return Scalar([&]() { m_Writer.Double(value); }); }
+        bool String(const char* string, SizeType length, bool copy)
+        {
+            return Scalar([&]() { m_Writer.String(string, length, copy); });
+        }
+        // Only called with kParseNumbersAsStringsFlag, which is not used
+        bool RawNumber(const char* string, SizeType length, bool copy)
+        {
+            return Scalar([&]() { m_Writer.RawNumber(string, length, copy); });
+        }
+
+        bool StartObject()
+        {
+            return StartContainer(false);
+        }
+
+        bool Key(const char* name, SizeType length, bool copy)
+        {
+            if (m_CaptureDepth > 0)
+            {
+                m_Writer.Key(name, length, copy);
+            }
+            else if (m_SkipDepth == 0)
+            {
+                // Only valid during this call when the stream is not parsed in place
+                m_Key.assign(name, length);
+            }
+            return true;
+        }
+
+        bool EndObject(SizeType memberCount)
+        {
+            if (m_CaptureDepth > 0)
+            {
+                m_Writer.EndObject(memberCount);
+            }
+            return EndContainer();
+        }
+
+        bool StartArray()
+        {
+            return StartContainer(true);
+        }
+
+        bool EndArray(SizeType elementCount)
+        {
+            if (m_CaptureDepth > 0)
+            {
+                m_Writer.EndArray(elementCount);
+            }
+            return EndContainer();
+        }
+
+    private:
+        enum class Visit
+        {
+            Skip,           // Not on the way to any selected pointer
+            Descend,        // On the way to a selected pointer
+            Capture         // A selected pointer itself
+        };
+
+        struct Level
+        {
+            bool isArray = false;
+            SizeType index = 0;
+        };
+
+        static bool IsPrefix(const Pointer& prefix, const Pointer& path)
+        {
+            if (prefix.GetTokenCount() > path.GetTokenCount())
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < prefix.GetTokenCount(); ++i)
+            {
+                const Pointer::Token& left = prefix.GetTokens()[i];
+                const Pointer::Token& right = path.GetTokens()[i];
+                if (left.length != right.length || std::memcmp(left.name, right.name, left.length) != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Matches the value that starts now against the selected pointers, its token is the current key or index of m_Levels.back()
+        Visit BeginValue()
+        {
+            const size_t depth = m_Levels.size();
+            Visit visit = Visit::Skip;
+            for (size_t i = 0; i < m_Selections.size(); ++i)
+            {
+                Selection& selection = m_Selections[i];
+                const size_t tokenCount = selection.pointer->GetTokenCount();
+                if (selection.isCaptured)
+                {
+                    continue;
+                }
+
+                if (depth > 0)
+                {
+                    if (selection.matched != depth - 1 || tokenCount < depth)
+                    {
+                        continue;
+                    }
+
+                    const Pointer::Token& token = selection.pointer->GetTokens()[depth - 1];
+                    const Level& parent = m_Levels.back();
+                    const bool isSame = parent.isArray ? token.index == parent.index :
+                        token.length == m_Key.size() && std::memcmp(token.name, m_Key.data(), m_Key.size()) == 0;
+                    if (!isSame)
+                    {
+                        continue;
+                    }
+                    selection.matched = depth;
+                }
+
+                if (tokenCount == depth)
+                {
+                    m_CaptureIndex = i;
+                    return Visit::Capture;
+                }
+                visit = Visit::Descend;
+            }
+            return visit;
+        }
+
+        // The value at the current depth is done, returns false to stop parsing once every pointer has been captured
+        bool EndValue()
+        {
+            const size_t depth = m_Levels.size();
+            if (depth == 0)
+            {
+                return !IsDone();
+            }
+
+            for (Selection& selection : m_Selections)
+            {
+                if (selection.matched == depth)
+                {
+                    selection.matched = depth - 1;
+                }
+            }
+
+            if (m_Levels.back().isArray)
+            {
+                ++m_Levels.back().index;
+            }
+            return !IsDone();
+        }
+
+        void BeginCapture()
+        {
+            m_Capture.Clear();
+            m_Writer.Reset(m_Capture);
+        }
+
+        bool EndCapture()
+        {
+            Selection& selection = m_Selections[m_CaptureIndex];
+            selection.json.assign(m_Capture.GetString(), m_Capture.GetSize());
+            selection.isCaptured = true;
+            ++m_CapturedCount;
+            return EndValue();
+        }
+
+        template <typename Write>
+        bool Scalar(Write&& write)
+        {
+            if (m_CaptureDepth > 0)
+            {
+                write();
+                return true;
+            }
+            if (m_SkipDepth > 0)
+            {
+                return true;
+            }
+
+            switch (BeginValue())
+            {
+            case Visit::Capture:
+                BeginCapture();
+                write();
+                return EndCapture();
+            default:
+                // A selected pointer that goes deeper than the document does is not there
+                return EndValue();
+            }
+        }
+
+        bool StartContainer(bool isArray)
+        {
+            if (m_CaptureDepth > 0)
+            {
+                ++m_CaptureDepth;
+                return isArray ? m_Writer.StartArray() : m_Writer.StartObject();
+            }
+            if (m_SkipDepth > 0)
+            {
+                ++m_SkipDepth;
+                return true;
+            }
+
+            switch (BeginValue())
+            {
+            case Visit::Capture:
+                BeginCapture();
+                m_CaptureDepth = 1;
+                return isArray ? m_Writer.StartArray() : m_Writer.StartObject();
+            case Visit::Descend:
+            {
+                Level level;
+                level.isArray = isArray;
+                m_Levels.push_back(level);
+                return true;
+            }
+            case Visit::Skip:
+            default:
+                m_SkipDepth = 1;
+                return true;
+            }
+        }
+
+        bool EndContainer()
+        {
+            if (m_CaptureDepth > 0)
+            {
+                return --m_CaptureDepth > 0 || EndCapture();
+            }
+            if (m_SkipDepth > 0)
+            {
+                return --m_SkipDepth > 0 || EndValue();
+            }
+
+            m_Levels.pop_back();
+            return EndValue();
+        }
+
+        std::vector<Selection> m_Selections;
+        size_t m_CapturedCount = 0;
+        size_t m_CaptureIndex = 0;
+        std::vector<Level> m_Levels;
+        std::string m_Key;
+        size_t m_SkipDepth = 0;
+        size_t m_CaptureDepth = 0;
+        rapidjson::StringBuffer m_Capture;
+        rapidjson::Writer<rapidjson::StringBuffer> m_Writer{ m_Capture };
+    };
+
+    // Parses stream with handler, then replaces the captured values in rttrObject
+    template <unsigned ParseFlags, typename Stream>
+    SerializationResult LoadSelection(Stream& stream, instance rttrObject, const std::vector<Pointer>& pointers)
+    {
+        PartialLoadHandler handler{ pointers };
+        rapidjson::Reader reader;
+        const ParseResult result = reader.Parse<ParseFlags>(stream, handler);
+        // The handler stops the parse itself once it has everything
+        if (result.IsError() && !(result.Code() == kParseErrorTermination && handler.IsDone()))
+        {
+            return ReportError(ErrorCode::ParseError, GetParseError_En(result.Code()), result.Offset());
+        }
+
+        Patcher patcher{ rttrObject };
+        Document document;
+        SerializationResult loadResult;
+        for (PartialLoadHandler::Selection& selection : handler.GetSelections())
+        {
+            // Pointers that are not in the document are left alone
+            if (!selection.isCaptured)
+            {
+                continue;
+            }
+
+            if (document.ParseInsitu(&selection.json[0]).HasParseError() || !patcher.Replace(*selection.pointer, document))
+            {
+                // The other selections are still loaded, the first failure is returned
+                rapidjson::StringBuffer path;
+                selection.pointer->Stringify(path);
+                const SerializationResult failure = ReportError(ErrorCode::PatchFailed, std::string_view(path.GetString(), path.GetSize()));
+                if (loadResult)
+                {
+                    loadResult = failure;
+                }
+            }
+        }
+        return loadResult;
+    }
+
+    // *********************************************************
+    // *Exposed Partial Load Functions
+    // *********************************************************
+    // json has to be null terminated and mutable, it is parsed in place
+    inline SerializationResult FromJsonFormatPartial(char* json, instance rttrObject, const std::vector<Pointer>& pointers)
+    {
+        if (json == nullptr || *json == '\0')
+        {
+            return ReportError(ErrorCode::EmptyBuffer);
+        }
+
+        InsituStringStream stream{ json };
+        return LoadSelection<kParseInsituFlag>(stream, rttrObject, pointers);
+    }
+
+    // Streams the file through a READ_BUFFER_SIZE buffer, parsing stops once every pointer has been found
+    inline SerializationResult DeserializeFromFilePartial(const std::filesystem::path& filePath, instance rttrObject, const std::vector<Pointer>& pointers)
+    {
+        FilePointer file = OpenFile(filePath, "rb");
+        if (!file)
+        {
+            return ReportError(ErrorCode::FileNotFound, filePath.u8string());
+        }
+
+        char readBuffer[READ_BUFFER_SIZE];
+        FileReadStream stream{ file.get(), readBuffer, sizeof(readBuffer) };
+        return LoadSelection<kParseDefaultFlags>(stream, rttrObject, pointers);
+    }
+}
+
+#endif
@@ -15,6 +15,7 @@
 #include <vector>
 #include <iostream>
 
+#include "MemberList.hpp"
 #include "SpaceAssert.h"
 
 /*  This namespace contains RTTR_REGISTRATION that is suppose to help register all classes, variables, functions that you would like to
@@ -49,6 +50,8 @@
     - method("function name", function);
     If you want to invoke/use the function you reflected, you can call InvokeGlobalRegisteredFunction("function name", {arguements});
     The reason why you use {} is because you need to wrap your arguments into a type variant.
+    For calls every frame, look the function up once with MethodHandle::FindGlobal("function name") and call InvokeGlobal/InvokeGlobalBatch,
+    class functions the same way with MethodHandle::Find<Class>("function name") and Invoke/InvokeBatch.
 
     - Use GetValueFromVariant<Type>(variant) if you would like to retrieve the values from the function you called.
 
@@ -146,27 +149,38 @@ namespace Reflect
         return function;
     }
 
-    inline std::vector<variant> InvokeGlobalRegisteredFunction(string_view nameOfFunction, std::vector<argument> args)
+    // Calls the function once per argument, use MethodHandle::FindGlobal and InvokeGlobalBatch for many values every frame
+    // The overload is picked by the type of each argument, like type::invoke does, and only looked up again when the type changes
+    inline std::vector<variant> InvokeGlobalRegisteredFunction(string_view nameOfFunction, const std::vector<argument>& args)
     {
-        method meth = type::get_global_method(nameOfFunction);
-
         // Variant will be valid if there are values inside it, else it will be invalid
         std::vector<variant> valuesAfterInvokingFunction;
 
         // Only invoke function if function is found
-        if (meth)
+        method overload = type::get_global_method(nameOfFunction);
+        if (overload)
         {
+            valuesAfterInvokingFunction.reserve(args.size());
+            type overloadType = type::get<void>();
             for (const argument& itr : args)
             {
-                valuesAfterInvokingFunction.emplace_back(type::invoke(nameOfFunction, { itr }));
+                if (itr.get_type() != overloadType)
+                {
+                    overloadType = itr.get_type();
+                    overload = type::get_global_method(nameOfFunction, { overloadType });
+                }
+
+                // No overload takes exactly this type, the rest of the matching (derived class pointers...) is left to type::invoke
+                valuesAfterInvokingFunction.emplace_back(overload ? overload.invoke(instance(), itr) : type::invoke(nameOfFunction, { itr }));
             }
         }
         return valuesAfterInvokingFunction;
     }
 
     // Invoke many times of the same function
+    // obj is taken by reference, a non const method changes the object passed in
     template <typename Class>
-    std::vector<variant> InvokeRegisteredClassFunctionRecursively(string_view nameOfFunction, string_view NameOfClass, Class obj, std::vector<argument> args)
+    std::vector<variant> InvokeRegisteredClassFunctionRecursively(string_view nameOfFunction, string_view NameOfClass, Class& obj, const std::vector<argument>& args)
     {
         type classType = type::get_by_name(NameOfClass);
 
@@ -174,6 +188,7 @@ namespace Reflect
 
         if (classType.is_valid())
         {
+            valueAfterInvokingFunction.reserve(args.size());
             for (const auto& itr : args)
             {
                 valueAfterInvokingFunction.emplace_back(classType.invoke(nameOfFunction, obj, { itr }));
@@ -186,9 +201,17 @@ namespace Reflect
         return valueAfterInvokingFunction;
     }
 
+    // Temporary objects, e.g. {}, whatever the method changes is dropped with them
+    template <typename Class>
+    std::vector<variant> InvokeRegisteredClassFunctionRecursively(string_view nameOfFunction, string_view NameOfClass, Class&& obj, const std::vector<argument>& args)
+    {
+        return InvokeRegisteredClassFunctionRecursively<Class>(nameOfFunction, NameOfClass, obj, args);
+    }
+
     // Invoke function according to function signature
+    // obj is taken by reference, a non const method changes the object passed in
     template <typename Class>
-    variant InvokeRegisteredClassFunction(string_view nameOfFunction, string_view NameOfClass, Class obj, std::vector<argument> args)
+    variant InvokeRegisteredClassFunction(string_view nameOfFunction, string_view NameOfClass, Class& obj, std::vector<argument> args)
     {
         type classType = type::get_by_name(NameOfClass);
 
@@ -205,6 +228,139 @@ namespace Reflect
         return valueAfterInvokingFunction;
     }
 
+    // Temporary objects, e.g. {}, whatever the method changes is dropped with them
+    template <typename Class>
+    variant InvokeRegisteredClassFunction(string_view nameOfFunction, string_view NameOfClass, Class&& obj, std::vector<argument> args)
+    {
+        return InvokeRegisteredClassFunction<Class>(nameOfFunction, NameOfClass, obj, std::move(args));
+    }
+
+    // Same as InvokeRegisteredClassFunction with the method looked up once, for functions called every frame
+    // Invoke takes the object by reference, a non const method changes the object passed in
+    // Example:
+    // static const MethodHandle radiusDouble = MethodHandle::Find<circle>("radiusDouble", { type::get<float>() });
+    // variant value = radiusDouble.Invoke(myCircle, 2.f);
+    class MethodHandle
+    {
+    public:
+        MethodHandle() = default;
+
+        // Overload of nameOfFunction on classType that takes parameterTypes, the first one called nameOfFunction if parameterTypes is empty
+        MethodHandle(const type& classType, string_view nameOfFunction, const std::vector<type>& parameterTypes = {}) :
+            m_Method{ parameterTypes.empty() ? classType.get_method(nameOfFunction) : classType.get_method(nameOfFunction, parameterTypes) }
+        {
+        }
+
+        template <typename Class>
+        static MethodHandle Find(string_view nameOfFunction, const std::vector<type>& parameterTypes = {})
+        {
+            return MethodHandle{ type::get<Class>(), nameOfFunction, parameterTypes };
+        }
+
+        static MethodHandle Find(string_view NameOfClass, string_view nameOfFunction, const std::vector<type>& parameterTypes = {})
+        {
+            return MethodHandle{ type::get_by_name(NameOfClass), nameOfFunction, parameterTypes };
+        }
+
+        // Function registered with registration::method, called through the InvokeGlobal functions
+        static MethodHandle FindGlobal(string_view nameOfFunction, const std::vector<type>& parameterTypes = {})
+        {
+            MethodHandle handle;
+            handle.m_Method = parameterTypes.empty() ? type::get_global_method(nameOfFunction) : type::get_global_method(nameOfFunction, parameterTypes);
+            return handle;
+        }
+
+        bool IsValid() const
+        {
+            return m_Method.is_valid();
+        }
+
+        explicit operator bool() const
+        {
+            return IsValid();
+        }
+
+        const method& GetMethod() const
+        {
+            return m_Method;
+        }
+
+        // Invalid variant if the handle is invalid or the arguments do not fit the method
+        template <typename Class, typename... Args>
+        variant Invoke(Class& obj, Args&&... args) const
+        {
+            return m_Method.invoke(obj, std::forward<Args>(args)...);
+        }
+
+        // More arguments than the 6 method::invoke takes directly
+        template <typename Class>
+        variant InvokeVariadic(Class& obj, const std::vector<argument>& args) const
+        {
+            return m_Method.invoke_variadic(obj, args);
+        }
+
+        // results[i] is the method called on objects[i] with the same args, results has room for count values
+        // Returns how many calls gave back a valid variant
+        template <typename Class, typename... Args>
+        size_t InvokeBatch(Class* objects, size_t count, variant* results, const Args&... args) const
+        {
+            size_t invokedCount = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                results[i] = m_Method.invoke(objects[i], args...);
+                invokedCount += results[i].is_valid() ? 1 : 0;
+            }
+            return invokedCount;
+        }
+
+        // Same as above with the return values taken out of the variants, results[i] is left alone if the call did not return a Result
+        template <typename Result, typename Class, typename... Args>
+        size_t InvokeBatchValues(Class* objects, size_t count, Result* results, const Args&... args) const
+        {
+            size_t invokedCount = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const variant value = m_Method.invoke(objects[i], args...);
+                if (value.is_type<Result>())
+                {
+                    results[i] = value.get_value<Result>();
+                    ++invokedCount;
+                }
+            }
+            return invokedCount;
+        }
+
+        template <typename... Args>
+        variant InvokeGlobal(Args&&... args) const
+        {
+            return m_Method.invoke(instance(), std::forward<Args>(args)...);
+        }
+
+        // outputs[i] is the function called with inputs[i], outputs has room for count values
+        // Small return values stay inside the variant, so a call allocates nothing
+        // Returns how many calls gave back an Output, outputs[i] is left alone for the others
+        template <typename Input, typename Output>
+        size_t InvokeGlobalBatch(const Input* inputs, size_t count, Output* outputs) const
+        {
+            const instance noObject;
+            size_t invokedCount = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const variant value = m_Method.invoke(noObject, inputs[i]);
+                if (value.is_type<Output>())
+                {
+                    outputs[i] = value.get_value<Output>();
+                    ++invokedCount;
+                }
+            }
+            return invokedCount;
+        }
+
+    private:
+        // rttr::method has no default constructor, a lookup that finds nothing gives the invalid one
+        method m_Method{ type::get<void>().get_method("") };
+    };
+
     template <typename Type>
     Type GetValueFromVariant(variant value)
     {
@@ -239,4 +395,22 @@ namespace Reflect
 
 }
 
+// Hot types, written and read through the functions generated from these once JSON::RegisterMemberList has been called for them
+template <>
+struct JSON::MemberList<Reflect::point2d>
+{
+    static constexpr auto members = std::make_tuple(
+        JSON::MakeMember("x", &Reflect::point2d::x),
+        JSON::MakeMember("y", &Reflect::point2d::y));
+};
+
+template <>
+struct JSON::MemberList<Reflect::Vector3>
+{
+    static constexpr auto members = std::make_tuple(
+        JSON::MakeMember("x", &Reflect::Vector3::x),
+        JSON::MakeMember("y", &Reflect::Vector3::y),
+        JSON::MakeMember("z", &Reflect::Vector3::z));
+};
+
 #endif
@@ -10,20 +10,41 @@
 #ifndef _SERIALIZER_HPP_
 #define _SERIALIZER_HPP_
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <deque>
 #include <iostream>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 
 #include "ContainerChecker.hpp"
+#include "Diagnostics.hpp"
+#include "SerializationPlan.hpp"
 #include "SpaceAssert.h"
+#include "Tracing.hpp"
 #include "TypeTraits.hpp"
 #include "rapidjson/document.h"
+#include "rapidjson/error/en.h"
+#include "rapidjson/filereadstream.h"
+#include "rapidjson/filewritestream.h"
 #include "rapidjson/prettywriter.h"
+#include "rapidjson/writer.h"
 #include "Reflect.hpp"
 
 #ifdef JSONWRITER
@@ -55,1023 +76,3702 @@ namespace JSON
     using namespace rapidjson;
     using namespace rttr;
 
-    class Writer : private PrettyWriter<StringBuffer>
+    // Output layout of the exposed serialize functions
+    // Pretty  -> Indented output, use this when you need to read/diff the file
+    // Compact -> No whitespace at all, use this for production saves
+    enum class JsonFormat
     {
-    public:
-        // Default Constructor
-        Writer() = default;
+        Pretty,
+        Compact
+    };
 
-        // Parametrized Constructor
-        Writer(PrettyWriter<StringBuffer>& writer) : m_Writer{ &writer }
+    // *********************************************************
+    // *File helpers, files are opened in binary mode so what the writer produces is what lands on disk
+    // *********************************************************
+    struct FileCloser
+    {
+        void operator()(std::FILE* file) const
         {
+            std::fclose(file);
         }
+    };
 
-        // *********************************************************
-        // *PrettyWriter Helper Functions to aid you in your serializing of data into JSON format
-        // *********************************************************
-        void StartObject() const
+    using FilePointer = std::unique_ptr<std::FILE, FileCloser>;
+
+    // mode is a fopen mode, e.g. "wb", "rb"
+    inline FilePointer OpenFile(const std::filesystem::path& filePath, const char* mode)
+    {
+        std::FILE* file = nullptr;
+#ifdef _WIN32
+        // Paths are wide on windows
+        const std::wstring wideMode{ mode, mode + std::char_traits<char>::length(mode) };
+        _wfopen_s(&file, filePath.c_str(), wideMode.c_str());
+#else
+        file = std::fopen(filePath.c_str(), mode);
+#endif
+        return FilePointer{ file };
+    }
+
+    // *********************************************************
+    // *Owned, mutable, null terminated copy of a file for Document::ParseInsitu
+    // *The parsed strings point into this buffer, so it has to outlive the Document
+    // *********************************************************
+    class InsituBuffer
+    {
+    public:
+        // Reads the whole file with a single read, no stringstream/std::string copies in between
+        bool ReadFile(const std::filesystem::path& filePath)
         {
-            m_Writer->StartObject();
+            m_Size = 0;
+
+            std::error_code error;
+            const uintmax_t fileSize = std::filesystem::file_size(filePath, error);
+            FilePointer file = OpenFile(filePath, "rb");
+            if (error || !file)
+            {
+                return false;
+            }
+
+            Reserve(static_cast<size_t>(fileSize) + 1);
+            // File might have shrunk since file_size, trust what fread returns
+            m_Size = std::fread(m_Data.get(), 1, static_cast<size_t>(fileSize), file.get());
+            m_Data[m_Size] = '\0';
+            return !std::ferror(file.get());
         }
 
-        void EndObject() const
+        // Copies json in, for callers that already have the text in memory
+        void Assign(const char* json, size_t size)
         {
-            m_Writer->EndObject();
+            Reserve(size + 1);
+            std::memcpy(m_Data.get(), json, size);
+            m_Data[size] = '\0';
+            m_Size = size;
         }
 
-        void StartArray() const
+        // Makes room for size characters and the null terminator, the caller writes the characters into the returned buffer
+        char* Resize(size_t size)
         {
-            m_Writer->StartArray();
+            Reserve(size + 1);
+            m_Data[size] = '\0';
+            m_Size = size;
+            return m_Data.get();
         }
 
-        void EndArray() const
+        char* GetData() const
         {
-            m_Writer->EndArray();
+            return m_Data.get();
         }
 
-        // PrettyWriter Option or Single Line Array
-        void SetFormatOptions(PrettyFormatOptions options) const
+        size_t GetSize() const
         {
-            m_Writer->SetFormatOptions(options);
+            return m_Size;
         }
 
-        void SetMaxDecimalPlace(int maxDecimalPlaces) const
+        bool Empty() const
         {
-            m_Writer->SetMaxDecimalPlaces(maxDecimalPlaces);
+            return m_Size == 0;
         }
 
-        void PutKey(const std::string& keyName) const
+    private:
+        // Only grows, so reading many files through one buffer stops allocating once it is big enough
+        // Not zero filled, everything up to m_Size is overwritten by the read anyway
+        void Reserve(size_t capacity)
         {
-            m_Writer->Key(keyName.c_str());
+            if (capacity > m_Capacity)
+            {
+                m_Data.reset(new char[capacity]);
+                m_Capacity = capacity;
+            }
         }
 
-        void PutNull() const
+        std::unique_ptr<char[]> m_Data;
+        size_t m_Size = 0;
+        size_t m_Capacity = 0;
+    };
+
+    // *********************************************************
+    // *Everything a load allocates, kept alive between loads so loading many files one after another stops allocating
+    // *The Document values go into one arena and the parse stack into another, both are MemoryPoolAllocators over a single block
+    // *Resetting between loads only rewinds the arenas, if a load did not fit its arena spilled into extra chunks
+    // *and the next Reset replaces the arena with one big enough for it, so after the biggest file has been seen once
+    // *a load only allocates what RTTR itself allocates while setting the values
+    // *One context per thread, the Document (and every string in it) is only valid until the next load through the same context
+    // *********************************************************
+    using ContextDocument = GenericDocument<UTF8<>, MemoryPoolAllocator<>, MemoryPoolAllocator<>>;
+
+    class DeserializationContext
+    {
+    public:
+        // Chunk size for the arenas before they have been sized by a load
+        static constexpr size_t ARENA_CHUNK_SIZE = 64 * 1024;
+        // First allocation of the parse stack, same as the Document default
+        static constexpr size_t PARSE_STACK_CAPACITY = 1024;
+
+        // Arenas are allocated by the first load and grown to fit by the ones after it
+        DeserializationContext() = default;
+
+        // The Document values start in buffer, which has to outlive the context
+        // A load that does not fit makes the context switch to an arena of its own
+        DeserializationContext(void* buffer, size_t size)
         {
-            m_Writer->Null();
+            m_Values.buffer = buffer;
+            m_Values.size = size;
         }
 
-        template <typename Type>
-        void PutValue(const Type& key)
+        // Not copyable, the Document points into the arenas
+        DeserializationContext(const DeserializationContext&) = delete;
+        DeserializationContext& operator=(const DeserializationContext&) = delete;
+
+        // Drops the previous Document and rewinds both arenas, O(1) when the previous load fit into them
+        void Reset()
         {
-            if constexpr (TYPETRAITS::are_same<Type, uint64_t >::value)
-                m_Writer->Uint64(key);
-            else if constexpr (TYPETRAITS::are_same<Type, int64_t >::value)
-                m_Writer->Int64(key);
-            else if constexpr (TYPETRAITS::are_same<Type, double>::value || TYPETRAITS::are_same<Type, float>::value)
-                m_Writer->Double(key);
-            else if constexpr (TYPETRAITS::are_same<Type, bool>::value)
-                m_Writer->Bool(key);
-            else if constexpr (TYPETRAITS::are_same<Type, int >::value)
-                m_Writer->Int(key);
-            else if constexpr (TYPETRAITS::are_same<Type, unsigned >::value)
-                m_Writer->Uint(key);
-            else if constexpr (TYPETRAITS::are_same<Type, std::string>::value || TYPETRAITS::are_same<Type, const char*>::value)
-                m_Writer->String(key.c_str());
-            else
-            {
-                // Should not hit this
-                std::cout << "Unable to inspect the defined Type, Seek Fail" << std::endl;
-                // Put null if seeks fail
-                m_Writer->Null();
-            }
+            m_Document.reset();
+            m_Values.Reset(m_BaseAllocator);
+            m_Stack.Reset(m_BaseAllocator);
         }
 
-        // Specialized for string if user did not pass in a std::string but passed in "..."
-        template <>
-        void PutValue<std::string>(const std::string& key)
+        // Resets and hands out an empty Document that allocates from the arenas
+        ContextDocument& NewDocument()
         {
-            m_Writer->String(key.c_str());
+            Reset();
+            return m_Document.emplace(&*m_Values.allocator, PARSE_STACK_CAPACITY, &*m_Stack.allocator);
         }
 
-        // For Sequence Containers -> (array, vector, deque, list, forward_list)
-        // For Associative Containers -> (map, unordered_map)
-        // Containee = std::allocator<Type>
-        template<typename Type, template<typename, typename...> class Container, typename... Containee>
-        void PutContainerValue(const std::string& key, const Container<Type, Containee...>& valueContainer)
+        // Parse stack for rapidjson::GenericReader, valid after Reset
+        MemoryPoolAllocator<>& GetStackAllocator()
         {
-            PutKey(key);
-            PutContainerValue(valueContainer);
+            return *m_Stack.allocator;
         }
 
-        // Specialized Version for serializing tuple container
-        template<typename... Containee>
-        void PutContainerTuple(const std::string& key, const std::tuple<Containee...>& valueContainer)
+        // File contents for the file loads, only grows
+        InsituBuffer& GetBuffer()
         {
-            PutKey(key);
-            PutContainerTuple(valueContainer);
+            return m_Buffer;
         }
-        // *********************************************************
 
-        // *********************************************************
-        // *Using RTTR Library API to help check the type of the variable before writing it to JSON version
-        // *********************************************************
-        bool WriteAtomicTypes(const type& type, const variant& variant)
+        // Size of the value arena, 0 until the first Reset
+        size_t GetArenaSize() const
         {
-            // Basic Primitive & Floating Point Types like int, unsigned, std::string, float, double
-            if (type.is_arithmetic())
-            {
-                if (type == type::get<bool>() || type == type::get<char>())
-                    this->PutValue(variant.to_bool());
-                else if (type == type::get<int8_t>())
-                    this->PutValue(variant.to_int8());
-                else if (type == type::get<int16_t>())
-                    this->PutValue(variant.to_int16());
-                else if (type == type::get<int32_t>())
-                    this->PutValue(variant.to_int32());
-                else if (type == type::get<int64_t>())
-                    this->PutValue(variant.to_int64());
-                else if (type == type::get<uint8_t>())
-                    this->PutValue(variant.to_uint8());
-                else if (type == type::get<uint16_t>())
-                    this->PutValue(variant.to_uint16());
-                else if (type == type::get<uint32_t>())
-                    this->PutValue(variant.to_uint32());
-                else if (type == type::get<uint64_t>())
-                    this->PutValue(variant.to_uint64());
-                else if (type == type::get<float>() || type == type::get<double>())
-                    this->PutValue(variant.to_double());
-                return true;
-            }
-
-            // Specialized version for std::string
-            if (type == type::get<std::string>() || type == type::get<const char*>())
-            {
-                this->PutValue<std::string>(variant.to_string());
-                return true;
-            }
+            return m_Values.size;
+        }
 
-            // Check if enum
-            if (type.is_enumeration())
+    private:
+        struct Arena
+        {
+            // Rewinds allocator to the start of buffer, replacing buffer first if the last use spilled past it
+            void Reset(CrtAllocator& baseAllocator)
             {
-                bool canConvertToString = false;
-                // Needs to check if its possible to convert custom types(variant) to std::string
-                const std::string result = variant.to_string(&canConvertToString);
-
-                if (canConvertToString)
-                {
-                    this->PutValue<std::string>(variant.to_string());
-                }
-                else
+                // Anything above the capacity of buffer are chunks allocated by the last use
+                if (allocator && allocator->Capacity() != capacity)
                 {
-                    canConvertToString = false;
-                    const uint64_t value = variant.to_uint64(&canConvertToString);
-                    if (canConvertToString)
-                    {
-                        this->PutValue(value);
-                    }
-                    else
+                    // Room for everything the last use needed in one block, with a margin for the chunk header
+                    size_t newSize = ARENA_CHUNK_SIZE;
+                    while (newSize < allocator->Capacity() + 64)
                     {
-                        this->PutNull();
+                        newSize *= 2;
                     }
+                    // Frees the spilled chunks, a caller buffer is left alone
+                    allocator.reset();
+                    owned.reset(new char[newSize]);
+                    buffer = owned.get();
+                    size = newSize;
                 }
-                return true;
-            }
 
-            // If all fails, then return false, probably will have to do a assert here
-            // assert("Not Primitive, Floating, std::string, Enum types");
-            return false;
-        }
+                if (allocator)
+                {
+                    // Only the block of buffer is left, nothing to free
+                    allocator->Clear();
+                    return;
+                }
 
-        void WriteArray(const variant_sequential_view& variantView)
-        {
-            this->StartArray();
-            // variantView can store containers/arithmetic/std::string/enums inside
-            // Those are actually copied over to variant, for e.g. I can std::vector<int> cat{1,2,3,4,5}
-            // And then i variant var = cat;
-            // Then variantView = var.create_variant_sequential_view();
-            // So this is how variantView came about, inside it will store a std::vector<int>.
-            for (const variant& item : variantView)
-            {
-                // Check if the item inside is a sequential container
-                if (item.is_sequential_container())
+                if (buffer)
                 {
-                    // Recursively call this function to add the item in one by one using WriteAtomicTypes
-                    WriteArray(item.create_sequential_view());
+                    allocator.emplace(buffer, size, ARENA_CHUNK_SIZE, &baseAllocator);
                 }
                 else
                 {
-                    // A wrapper type is a class which encapsulate an instance of another type. This encapsulate type is also called wrapped type.
-                    variant wrappedVariant = item.extract_wrapped_value();
-                    type valueType = wrappedVariant.get_type();
-
-                    if (valueType.is_arithmetic() || valueType == type::get<std::string>() || valueType.is_enumeration())
-                    {
-                        WriteAtomicTypes(valueType, wrappedVariant);
-                    }
-                    else
-                    {
-                        // Is an object, object refers to your class/struct object
-                        WriteToJSONRecursively(wrappedVariant);
-                    }
+                    allocator.emplace(ARENA_CHUNK_SIZE, &baseAllocator);
                 }
+                capacity = allocator->Capacity();
             }
-            this->EndArray();
-        }
-
-        void WriteAssociativeContainer(const variant_associative_view& variantView)
-        {
-            static const string_view key_name("key");
-            static const string_view value_name("value");
 
-            this->StartArray();
-            if (variantView.is_key_only_type())
-            {
-                for (const std::pair<variant, variant>& item : variantView)
-                {
-                    WriteVariant(item.first);
-                }
-            }
-            else
-            {
-                for (const std::pair<variant, variant>& item : variantView)
-                {
-                    this->StartObject();
+            std::unique_ptr<char[]> owned;
+            void* buffer = nullptr;
+            size_t size = 0;
+            // Capacity of the allocator while it only has buffer
+            size_t capacity = 0;
+            std::optional<MemoryPoolAllocator<>> allocator;
+        };
+
+        CrtAllocator m_BaseAllocator;
+        Arena m_Values;
+        Arena m_Stack;
+        std::optional<ContextDocument> m_Document;
+        InsituBuffer m_Buffer;
+    };
 
-                    this->PutKey(key_name.data());
-                    WriteVariant(item.first);
+    // *********************************************************
+    // *Output stream with a fixed size buffer that the writers write into
+    // *Once the buffer is full it is drained into the sink, either a FILE* or a std::string
+    // *Saving to a file only holds WRITE_BUFFER_SIZE bytes of the document in memory no matter how big the save is
+    // *********************************************************
+    constexpr size_t WRITE_BUFFER_SIZE = 64 * 1024;
+    constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
 
-                    this->PutKey(value_name.data());
-                    WriteVariant(item.second);
+    class OutputStream
+    {
+    public:
+        typedef char Ch;
 
-                    this->EndObject();
-                }
-            }
-            this->EndArray();
+        // Drains into file, buffer has to outlive the stream
+        OutputStream(std::FILE* file, char* buffer, size_t bufferSize) :
+            m_File{ file }, m_Buffer{ buffer }, m_BufferEnd{ buffer + bufferSize }, m_Current{ buffer }
+        {
+            RAPIDJSON_ASSERT(file && buffer && bufferSize > 0);
         }
 
-        bool WriteVariant(const variant& variant)
+        // Drains into output, used by the in memory versions
+        OutputStream(std::string& output, char* buffer, size_t bufferSize) :
+            m_String{ &output }, m_Buffer{ buffer }, m_BufferEnd{ buffer + bufferSize }, m_Current{ buffer }
         {
-            type valueType = variant.get_type();
-            type wrappedType = valueType.is_wrapper() ? valueType.get_wrapped_type() : valueType;
-            const bool isWrappedType = wrappedType != valueType;
+            RAPIDJSON_ASSERT(buffer && bufferSize > 0);
+        }
 
-            this->SetFormatOptions(PrettyFormatOptions::kFormatDefault);
-            if (WriteAtomicTypes(isWrappedType ? wrappedType : valueType, isWrappedType ? variant.extract_wrapped_value() : variant))
+        void Put(Ch c)
+        {
+            JSON_TRACE_BYTES(1);
+            if (m_Current >= m_BufferEnd)
             {
-                // Do nothing
+                Drain();
             }
-            else if (variant.is_sequential_container())
+            *m_Current++ = c;
+        }
+
+        // Bulk version of Put, a run bigger than the buffer goes straight to the sink
+        void Write(const Ch* data, size_t size)
+        {
+            JSON_TRACE_BYTES(size);
+            if (size > static_cast<size_t>(m_BufferEnd - m_Current))
             {
-                // Write single line array when serializing a sequential container
-                this->SetFormatOptions(PrettyFormatOptions::kFormatSingleLineArray);
-                WriteArray(variant.create_sequential_view());
+                Drain();
             }
-            else if (variant.is_associative_container())
+
+            if (size >= static_cast<size_t>(m_BufferEnd - m_Buffer))
             {
-                WriteAssociativeContainer(variant.create_associative_view());
+                WriteToSink(data, size);
+                return;
             }
-            else
+            std::memcpy(m_Current, data, size);
+            m_Current += size;
+        }
+
+        void Flush()
+        {
+            Drain();
+            if (m_File && std::fflush(m_File) != 0)
             {
-                const auto childProperties = isWrappedType ? wrappedType.get_properties() : valueType.get_properties();
-                if (!childProperties.empty())
-                {
-                    WriteToJSONRecursively(variant);
-                }
-                else
-                {
-                    bool canConvertToString = false;
-                    const std::string value = variant.to_string(&canConvertToString);
-                    if (!canConvertToString)
-                    {
-                        this->PutKey(value);
-                        return false;
-                    }
-                    this->PutKey(value);
-                }
+                m_Good = false;
             }
-            return true;
         }
 
-        void WriteToJSONRecursively(const instance& rttrObject)
+        // Drops whatever has not been drained yet, for streams that are reused across saves
+        void Reset()
         {
-            this->StartObject();
-            instance obj = rttrObject.get_type().get_raw_type().is_wrapper() ? rttrObject.get_wrapped_instance() : rttrObject;
+            m_Current = m_Buffer;
+            m_Good = true;
+        }
 
-            // Getting your derived class where the list will contain all your base type properties also
-            auto propertiesList = obj.get_derived_type().get_properties();
-            for (property propertie : propertiesList)
-            {
-                // Skip properties that are marked NO_SERIALIZE
-                if (propertie.get_metadata("NO_SERIALIZE"))
-                {
-                    continue;
-                }
+        // False if any write to the file failed
+        bool Good() const
+        {
+            return m_Good;
+        }
 
-                variant propertyValue = propertie.get_value(obj);
+        // Not implemented, the stream is output only
+        Ch Peek() const { RAPIDJSON_ASSERT(false); return 0; }
+        Ch Take() { RAPIDJSON_ASSERT(false); return 0; }
+        size_t Tell() const { RAPIDJSON_ASSERT(false); return 0; }
+        Ch* PutBegin() { RAPIDJSON_ASSERT(false); return 0; }
+        size_t PutEnd(Ch*) { RAPIDJSON_ASSERT(false); return 0; }
 
-                if (!propertyValue)
-                {
-                    // Cannot serialize, because we cannot retrieve the value
-                    std::cerr << "Unable to retrieve property value!" << std::endl;
-                    continue;
-                }
+    private:
+        void Drain()
+        {
+            const size_t size = static_cast<size_t>(m_Current - m_Buffer);
+            if (size == 0)
+            {
+                return;
+            }
 
-                const string_view name = propertie.get_name();
-                this->PutKey(name.data());
+            WriteToSink(m_Buffer, size);
+            m_Current = m_Buffer;
+        }
 
-                if (!WriteVariant(propertyValue))
+        void WriteToSink(const Ch* data, size_t size)
+        {
+            if (m_File)
+            {
+                if (std::fwrite(data, 1, size, m_File) < size)
                 {
-                    std::cerr << "Cannot serialize property: " << name << std::endl;
+                    m_Good = false;
                 }
             }
-
-            this->EndObject();
+            else
+            {
+                m_String->append(data, size);
+            }
         }
-        // *********************************************************
 
-        // *********************************************************
-        // *Getters for private members
-        // *********************************************************
-        PrettyWriter<StringBuffer>* GetPrettyWriter() const
-        {
-            return m_Writer;
-        }
+        std::FILE* m_File = nullptr;
+        std::string* m_String = nullptr;
+        char* m_Buffer = nullptr;
+        char* m_BufferEnd = nullptr;
+        char* m_Current = nullptr;
+        bool m_Good = true;
+    };
 
-    private:
-        // Private Variables
-        PrettyWriter<StringBuffer>* m_Writer = nullptr;
+    // ************************************************
+    // Templated structs to help me check if the output handler is a PrettyWriter
+    // Only PrettyWriter has format options, rapidjson::Writer does not
+    // ************************************************
+    template <typename>
+    struct is_pretty_writer : std::false_type {};
 
-        // Private Functions
-        //TODO:: Multimap , Multiset not fully tested
-        template<typename Type, template<typename, typename...> class Container, typename... Containee>
-        void PutContainerValue(const Container<Type, Containee...>& valueContainer)
+    template <typename OutputStream, typename SourceEncoding, typename TargetEncoding, typename StackAllocator, unsigned WriteFlags>
+    struct is_pretty_writer<PrettyWriter<OutputStream, SourceEncoding, TargetEncoding, StackAllocator, WriteFlags>> : std::true_type {};
+
+    // Handlers that length prefix their arrays take the element count in StartArray (Binary::Encoder)
+    template <typename OutputHandler, typename = void>
+    struct has_sized_arrays : std::false_type {};
+
+    template <typename OutputHandler>
+    struct has_sized_arrays<OutputHandler, std::void_t<decltype(std::declval<OutputHandler&>().StartArray(SizeType{}))>> : std::true_type {};
+
+    // Handlers that write property ids instead of names (Binary::Encoder)
+    template <typename OutputHandler, typename = void>
+    struct has_property_ids : std::false_type {};
+
+    template <typename OutputHandler>
+    struct has_property_ids<OutputHandler, std::void_t<decltype(std::declval<OutputHandler&>().PropertyId(uint32_t{}))>> : std::true_type {};
+
+    // Handlers that keep floats as floats instead of widening them to double (Binary::Encoder)
+    template <typename OutputHandler, typename = void>
+    struct has_float : std::false_type {};
+
+    template <typename OutputHandler>
+    struct has_float<OutputHandler, std::void_t<decltype(std::declval<OutputHandler&>().Float(float{}))>> : std::true_type {};
+    // ************************************************
+
+    // *********************************************************
+    // *Deep comparison for the delta functions, walks values the way the Writer does
+    // *Objects are compared property by property (NO_SERIALIZE ones are left out), containers element by element
+    // *Wrappers (pointers, shared_ptr) are equal only if they point to the same thing
+    // *********************************************************
+    inline bool ValuesEqual(const variant& value, const variant& baseline);
+
+    // Every serialized property of object equal to the one of baseline, both have to be of the same type
+    inline bool ObjectsEqual(const instance& object, const instance& baseline)
+    {
+        const TypePlan& plan = GetTypePlan(object.get_derived_type());
+        for (const PropertyPlan& propertyPlan : plan.properties)
         {
-            StartArray();
-            // When dealing with containers, I would want the JSON file to be in one line
-            SetFormatOptions(kFormatSingleLineArray);
+            if (!propertyPlan.noSerialize && !ValuesEqual(propertyPlan.prop.get_value(object), propertyPlan.prop.get_value(baseline)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 
-            if constexpr (TYPETRAITS::is_pair<std::decay_t<decltype(*valueContainer.begin())>>::value)
+    inline bool ValuesEqual(const variant& value, const variant& baseline)
+    {
+        const type valueType = value.get_type();
+        if (valueType != baseline.get_type())
+        {
+            return false;
+        }
+
+        if (valueType.is_wrapper() || GetAtomicType(valueType) != AtomicType::None || valueType.is_arithmetic() || valueType.is_enumeration())
+        {
+            return value == baseline;
+        }
+
+        // Contiguous arithmetic containers are compared as raw memory
+        if (const ContiguousContainer* container = FindContiguousContainer(valueType))
+        {
+            const void* valueData = nullptr;
+            const void* baselineData = nullptr;
+            size_t valueCount = 0;
+            size_t baselineCount = 0;
+            if (container->view(value, valueData, valueCount) && container->view(baseline, baselineData, baselineCount))
             {
-                for (const auto& itr : valueContainer)
+                return valueCount == baselineCount && (valueCount == 0 || std::memcmp(valueData, baselineData, valueCount * container->elementSize) == 0);
+            }
+        }
+
+        if (value.is_sequential_container())
+        {
+            const variant_sequential_view valueView = value.create_sequential_view();
+            const variant_sequential_view baselineView = baseline.create_sequential_view();
+            if (valueView.get_size() != baselineView.get_size())
+            {
+                return false;
+            }
+
+            for (size_t index = 0; index < valueView.get_size(); ++index)
+            {
+                if (!ValuesEqual(valueView.get_value(index).extract_wrapped_value(), baselineView.get_value(index).extract_wrapped_value()))
                 {
-                    // Safety Check for same Type, unable to StartObject for same type
-                    if (TYPETRAITS::are_same<Type, Containee...>::value)
-                    {
-                        PutKey(itr.first);
-                        PutValue(itr.second);
-                    }
-                    else
-                    {
-                        StartObject();
-                        PutKey(itr.first);
-                        PutValue(itr.second);
-                        EndObject();
-                    }
+                    return false;
                 }
             }
-            else
+            return true;
+        }
+
+        // Compared in iteration order, unordered containers that hold the same entries in a different order count as different
+        if (value.is_associative_container())
+        {
+            const variant_associative_view valueView = value.create_associative_view();
+            const variant_associative_view baselineView = baseline.create_associative_view();
+            if (valueView.get_size() != baselineView.get_size())
             {
-                for (const auto& itr : valueContainer)
+                return false;
+            }
+
+            for (auto valueItem = valueView.begin(), baselineItem = baselineView.begin(); valueItem != valueView.end(); ++valueItem, ++baselineItem)
+            {
+                if (!ValuesEqual(valueItem.get_key().extract_wrapped_value(), baselineItem.get_key().extract_wrapped_value()) ||
+                    !ValuesEqual(valueItem.get_value().extract_wrapped_value(), baselineItem.get_value().extract_wrapped_value()))
                 {
-                    PutValue(itr);
+                    return false;
                 }
             }
-            EndArray();
+            return true;
         }
 
-        template<typename Function, typename Tuple>
-        void GetAllTupleElements(Function&& function, Tuple&& tuple)
+        if (!valueType.get_properties().empty())
         {
-            std::apply([&function](auto&&... Args)
-                {
-                    (function(std::forward<decltype(Args)>(Args)), ...);
-                },
-                std::forward<Tuple>(tuple));
+            return ObjectsEqual(value, baseline);
         }
 
-        template<typename... Containee>
-        void PutContainerTuple(const std::tuple<Containee...>& valueContainer)
+        // Types without properties go through their registered comparator, no comparator counts as different
+        return value == baseline;
+    }
+
+    // *********************************************************
+    // *Objects behind the registered references of a graph, in the order they are given ids (ObjectGraph.hpp)
+    // *The writer adds an object the first time a pointer to it is written, the reader creates them all before reading any of them
+    // *********************************************************
+    class ReferenceTable
+    {
+    public:
+        // Id of the object at address, added to the table the first time it is seen
+        uint32_t GetId(const void* address, const ReferenceType& reference)
         {
-            StartArray();
-            // When dealing with containers, I would want the JSON file to be in one line
-            SetFormatOptions(kFormatSingleLineArray);
+            const auto inserted = m_Ids.emplace(address, static_cast<uint32_t>(m_Objects.size()));
+            if (inserted.second)
+            {
+                m_Objects.push_back(Entry{ std::shared_ptr<void>(), const_cast<void*>(address), &reference });
+            }
+            return inserted.first->second;
+        }
 
-            GetAllTupleElements([&](auto&& Args)
-                {
-                    PutValue(Args);
-                }, valueContainer);
+        // Reading, the object of the next id, made through reference
+        void Add(std::shared_ptr<void> object, const ReferenceType& reference)
+        {
+            void* address = object.get();
+            m_Objects.push_back(Entry{ std::move(object), address, &reference });
+        }
 
-            EndArray();
+        // Pointer to the object of id as reference's pointer type, invalid if there is no such id or the object is of another type
+        variant MakePointer(size_t id, const ReferenceType& reference) const
+        {
+            if (id >= m_Objects.size() || m_Objects[id].reference->objectType != reference.objectType)
+            {
+                return variant();
+            }
+            return reference.make(m_Objects[id].object);
+        }
+
+        size_t GetCount() const
+        {
+            return m_Objects.size();
+        }
+
+        instance GetObject(size_t id) const
+        {
+            return m_Objects[id].reference->object(m_Objects[id].address);
+        }
+
+        const type& GetObjectType(size_t id) const
+        {
+            return m_Objects[id].reference->objectType;
+        }
+
+        // Reading, the objects made for the ids
+        std::vector<std::shared_ptr<void>> TakeObjects()
+        {
+            std::vector<std::shared_ptr<void>> objects;
+            objects.reserve(m_Objects.size());
+            for (Entry& entry : m_Objects)
+            {
+                objects.push_back(std::move(entry.object));
+            }
+            return objects;
         }
+
+    private:
+        struct Entry
+        {
+            // Only owned when reading
+            std::shared_ptr<void> object;
+            void* address;
+            const ReferenceType* reference;
+        };
+
+        std::unordered_map<const void*, uint32_t> m_Ids;
+        std::vector<Entry> m_Objects;
     };
 
-    class Reader
+    // OutputHandler is any rapidjson SAX writer, PrettyWriter<...> or rapidjson::Writer<...>, or Binary::Encoder
+    // The RTTR walk is the same for every handler, only the output differs
+    template <typename OutputHandler>
+    class GenericWriter
     {
     public:
         // Default Constructor
-        Reader() = default;
+        GenericWriter() = default;
 
         // Parametrized Constructor
-        Reader(Value& data) : m_Data{ &data }
+        GenericWriter(OutputHandler& writer) : m_Writer{ &writer }
         {
         }
 
-        bool IsNull() const
+        // *********************************************************
+        // *PrettyWriter Helper Functions to aid you in your serializing of data into JSON format
+        // *********************************************************
+        void StartObject() const
         {
-            return m_Data->IsNull();
+            m_Writer->StartObject();
         }
 
-        bool IsObject() const
+        void EndObject() const
         {
-            return m_Data->IsObject();
+            m_Writer->EndObject();
         }
 
-        bool IsArray() const
+        void StartArray() const
         {
-            return m_Data->IsArray();
+            m_Writer->StartArray();
         }
 
-        bool HasMember(const std::string& name) const
+        // Same as StartArray, handlers that length prefix their arrays get count up front
+        void StartArray(size_t count) const
         {
-            return m_Data->HasMember(name.c_str());
+            if constexpr (has_sized_arrays<OutputHandler>::value)
+                m_Writer->StartArray(static_cast<SizeType>(count));
+            else
+                m_Writer->StartArray();
         }
 
-        // More optimized version compared to HasMember where it perform 1 seek instead of 2 seeks
-        // Please use this
-        GenericValue<UTF8<>>::MemberIterator FindMember(const std::string& name) const
+        void EndArray() const
         {
-            // Checking through the array if this member exist,
-            // Return false if it reaches the end with no result
-            return m_Data->FindMember(name.c_str());
+            m_Writer->EndArray();
         }
 
-        Value& ReadRawValue(const std::string& Key) const
+        // PrettyWriter Option or Single Line Array
+        void SetFormatOptions(PrettyFormatOptions options) const
         {
-            return (*m_Data)[Key.c_str()];
+            // Compact writers have no formatting to change
+            if constexpr (is_pretty_writer<OutputHandler>::value)
+                m_Writer->SetFormatOptions(options);
         }
 
-        template <typename TValue>
-        TValue ReadValue(const std::string& Key)
+        void SetMaxDecimalPlace(int maxDecimalPlaces) const
         {
-            // Check if the key given is valid
-            if (m_Data->FindMember(Key.c_str()) == m_Data->MemberEnd())
-            {
-                std::cout << "Key provided is not valid" << std::endl;
-                //TODO:: Replace with own assert
-                assert(false);
-            }
+            m_Writer->SetMaxDecimalPlaces(maxDecimalPlaces);
+        }
 
-            const Value& value = (*m_Data)[Key.c_str()];
+        // Registered pointers are written as {"$ref": id} into references instead of writing what they point to, nullptr turns it off
+        void SetReferences(ReferenceTable* references)
+        {
+            m_References = references;
+        }
 
-            if constexpr (TYPETRAITS::are_same<TValue, uint64_t>::value)
-                return value.GetUint64();
-            if constexpr (TYPETRAITS::are_same<TValue, int64_t>::value)
-                return value.GetInt64();
-            if constexpr (TYPETRAITS::are_same<TValue, double>::value)
-                return value.GetDouble();
-            if constexpr (TYPETRAITS::are_same<TValue, float>::value)
-                return value.GetFloat();
-            if constexpr (TYPETRAITS::are_same<TValue, bool>::value)
-                return value.GetBool();
-            if constexpr (TYPETRAITS::are_same<TValue, int>::value)
-                return value.GetInt();
-            if constexpr (TYPETRAITS::are_same<TValue, unsigned>::value)
-                return value.GetUint();
-            if constexpr (TYPETRAITS::are_same<TValue, std::string>::value || TYPETRAITS::are_same<TValue, const char*>::value)
-                return value.GetString();
+        void PutKey(const std::string& keyName) const
+        {
+            m_Writer->Key(keyName.c_str());
+        }
 
-            // Do a assert here
-            throw 0;
+        // encodedKey is already quoted and escaped (PropertyPlan::encodedKey), so it is copied out as is
+        void PutEncodedKey(const std::string& encodedKey) const
+        {
+            m_Writer->RawValue(encodedKey.data(), encodedKey.size(), kStringType);
         }
 
-        template <typename T, typename... TValue, typename Encoding, typename Allocator = RAPIDJSON_DEFAULT_ALLOCATOR>
-        T ReadValue(const GenericValue<Encoding, Allocator>& Value)
+        // Key of the property at index in its TypePlan, the index itself for handlers that write property ids
+        void PutPropertyKey(const PropertyPlan& propertyPlan, size_t index) const
         {
-            if constexpr (TYPETRAITS::are_same<T, uint64_t>::value)
-                return Value.GetUint64();
-            if constexpr (TYPETRAITS::are_same<T, int64_t>::value)
-                return Value.GetInt64();
-            if constexpr (TYPETRAITS::are_same<T, double>::value)
-                return Value.GetDouble();
-            if constexpr (TYPETRAITS::are_same<T, float>::value)
-                return Value.GetFloat();
-            if constexpr (TYPETRAITS::are_same<T, bool>::value)
-                return Value.GetBool();
-            if constexpr (TYPETRAITS::are_same<T, int>::value)
-                return Value.GetInt();
-            if constexpr (TYPETRAITS::are_same<T, unsigned>::value)
-                return Value.GetUint();
-            if constexpr (TYPETRAITS::are_same<T, std::string>::value || TYPETRAITS::are_same<T, const char*>::value)
-                return Value.GetString();
+            if constexpr (has_property_ids<OutputHandler>::value)
+                m_Writer->PropertyId(static_cast<uint32_t>(index));
+            else
+                PutEncodedKey(propertyPlan.encodedKey);
+        }
 
-            // Do a assert here
-            throw 0;
+        void PutNull() const
+        {
+            m_Writer->Null();
         }
 
-        template<typename Type, template<typename, typename...> class Container, typename... Containee>
-        void ReadContainerValue(Container<Type, Containee...>& valueContainer, const std::string& Key)
+        template <typename Type>
+        void PutValue(const Type& key)
         {
-            // Check if the key given is valid
-            if (m_Data->FindMember(Key.c_str()) == m_Data->MemberEnd())
+            if constexpr (TYPETRAITS::are_same<Type, uint64_t >::value)
+                m_Writer->Uint64(key);
+            else if constexpr (TYPETRAITS::are_same<Type, int64_t >::value)
+                m_Writer->Int64(key);
+            else if constexpr (TYPETRAITS::are_same<Type, double>::value || TYPETRAITS::are_same<Type, float>::value)
+                m_Writer->Double(key);
+            else if constexpr (TYPETRAITS::are_same<Type, bool>::value)
+                m_Writer->Bool(key);
+            else if constexpr (TYPETRAITS::are_same<Type, int >::value)
+                m_Writer->Int(key);
+            else if constexpr (TYPETRAITS::are_same<Type, unsigned >::value)
+                m_Writer->Uint(key);
+            else if constexpr (TYPETRAITS::are_same<Type, std::string>::value || TYPETRAITS::are_same<Type, const char*>::value)
+                m_Writer->String(key.c_str());
+            else
             {
-                std::cout << "Key provided is not valid" << std::endl;
-                //TODO:: Replace with own assert
-                assert(false);
+                // Should not hit this
+                ReportDiagnostic(ErrorCode::UnsupportedType, "Unable to inspect the defined Type, Seek Fail");
+                // Put null if seeks fail
+                m_Writer->Null();
             }
+        }
 
-            const Value& data = (*m_Data)[Key.c_str()];
-
-            // Check if container contains pair -> map, multimap, unordered map...
-            if constexpr (TYPETRAITS::is_pair<std::decay_t<decltype(*valueContainer.begin())>>::value)
-            {
-                // Check if m_Data is null
-                if (IsNull())
-                {
-                    std::cout << "m_Data is null" << std::endl;
-                    assert(false);
-                    // Might want to do some assert here
-                }
+        // For Sequence Containers -> (array, vector, deque, list, forward_list)
+        // For Associative Containers -> (map, unordered_map)
+        // Containee = std::allocator<Type>
+        template<typename Type, template<typename, typename...> class Container, typename... Containee>
+        void PutContainerValue(const std::string& key, const Container<Type, Containee...>& valueContainer)
+        {
+            PutKey(key);
+            PutContainerValue(valueContainer);
+        }
 
-                if (data.IsArray())
-                {
-                    for (const auto& itr : data.GetArray())
-                    {
-                        if (itr.IsObject())
-                        {
-                            for (auto m = itr.MemberBegin(); m != itr.MemberEnd(); ++m)
-                            {
-                                const std::string key = m->name.GetString();
-                                auto value = ReadValue<Containee...>(m->value);
-                                valueContainer.emplace(std::make_pair(key, value));
-                            }
-                        }
-                    }
-                }
-            }
-            // This is vector, deque, set, list...
-            else
-            {
-                if (data.IsArray())
-                {
-                    for (SizeType i = 0; i < data.Size(); ++i)
-                    {
-                        valueContainer.push_back(ReadValue<Type>(data[i]));
-                    }
-                }
-            }
-        }
-
-        // TODO:: WIP
-        template<typename Type, template<typename, typename...> class Container, typename... Containee>
-        void ReadTupleValue(Container<Type, Containee...>& valueContainer, const std::string& Key)
+        // Specialized Version for serializing tuple container
+        template<typename... Containee>
+        void PutContainerTuple(const std::string& key, const std::tuple<Containee...>& valueContainer)
         {
-            //const Value& data = (*m_Data)[Key.c_str()];
-
-            //if (data.IsArray())
-            //{
-            //    for (SizeType i = 0; i < data.Size(); ++i)
-            //    {
-            //        std::cout << GetValue<Containee...>(data[i]) << std::endl;
-            //    }
-
-            //    //auto tupleSize = std::tuple_size<decltype(valueContainer)>::value;
-            //    //std::cout << tupleSize << std::endl;
-            //}
+            PutKey(key);
+            PutContainerTuple(valueContainer);
         }
-
+        // *********************************************************
 
         // *********************************************************
-        // *Using RTTR Library API to help retrieve the value + type from JSON value as a form of variant(rttr variant class which can be used for any type)
+        // *Using RTTR Library API to help check the type of the variable before writing it to JSON version
         // *********************************************************
 
-        // Variant class allows us to store any type, and it is able to convert the type you want transparently
-        variant ReadAtomicTypes(Value& jsonValue)
+        // Writes value through the atomic dispatch table, returns false if atomicType is not an atomic type
+        // value has to hold exactly the type atomicType was made from
+        bool WriteAtomic(AtomicType atomicType, const variant& value)
         {
-            switch (jsonValue.GetType())
-            {
-            case kNullType:
-                break;
-            case kFalseType:
-            case kTrueType:
-                return jsonValue.GetBool();
-            case kObjectType:
-            case kArrayType:
-                return variant();
-            case kStringType:
-                return std::string(jsonValue.GetString());
-            case kNumberType:
+            if (atomicType == AtomicType::None)
             {
-                if (jsonValue.IsInt())
-                    return jsonValue.GetInt();
-                if (jsonValue.IsUint())
-                    return jsonValue.GetUint();
-                if (jsonValue.IsInt64())
-                    return jsonValue.GetInt64();
-                if (jsonValue.IsUint64())
-                    return jsonValue.GetUint64();
-                if (jsonValue.IsFloat())
-                    return jsonValue.GetFloat();
-                if (jsonValue.IsDouble())
-                    return jsonValue.GetDouble();
-                break;
-            }
+                return false;
             }
-            return variant();
+            ATOMIC_WRITERS[static_cast<size_t>(atomicType)](*m_Writer, value);
+            return true;
         }
 
-        // Read the all the values that should be extracted out from the JSON Value
-        variant ReadValue(const type& ArgType, Value::MemberIterator& itr)
+        // Writes a contiguous arithmetic container as one tight loop over its memory, returns false if value does not hold it
+        bool WriteContiguous(const ContiguousContainer& container, const variant& value)
         {
-            Value& jsonValue = itr->value;
-            variant extractedValue = ReadAtomicTypes(jsonValue);
+            const void* data = nullptr;
+            size_t count = 0;
+            if (!container.view(value, data, count))
+            {
+                return false;
+            }
 
-            // Check if the value we got from JSON can be converted to the type passed in
-            bool canConvertAtomicValueToType = extractedValue.can_convert(ArgType);
+            this->StartArray(count);
+            CONTIGUOUS_WRITERS[static_cast<size_t>(container.elementType)](*m_Writer, data, count);
+            this->EndArray();
+            return true;
+        }
 
-            if (canConvertAtomicValueToType)
+        bool WriteAtomicTypes(const type& type, const variant& variant)
+        {
+            // Basic Primitive & Floating Point Types like int, unsigned, std::string, float, double, enums
+            if (WriteAtomic(GetAtomicType(type), variant))
             {
-                canConvertAtomicValueToType = extractedValue.convert(ArgType);
+                return true;
             }
 
-            if (!canConvertAtomicValueToType)
+            // Arithmetic types without a table entry (e.g. long long on linux, long on windows)
+            if (type.is_arithmetic())
             {
-                if (jsonValue.IsObject())
-                {
-                    // Returns a public constructor whose parameters match the types in the specified list, else return default constructor
-                    constructor ctor = ArgType.get_constructor();
-
-                    for (const constructor& item : ArgType.get_constructors())
-                    {
-                        // If the item type is the same as ArgType, make the constructor to return the type I want
-                        if (item.get_instantiated_type() == ArgType)
-                        {
-                            ctor = item;
-                        }
-                    }
-                    // Invokes the constructor of type returned by get_instantiated_type()
-                    // Need to invoke constructor to get my variant object
-                    // Thats why I checked whether the item is same type as ArgType
-                    extractedValue = ctor.invoke();
-                    ReadFromJsonRecursively(extractedValue, jsonValue);
-                }
+                this->PutValue(variant.to_double());
+                return true;
             }
-            return extractedValue;
+
+            // If all fails, then return false, probably will have to do a assert here
+            // assert("Not Primitive, Floating, std::string, Enum types");
+            return false;
         }
 
-        void ReadArray(variant_sequential_view& variantView, Value& jsonArrayValue)
+        void WriteArray(const variant_sequential_view& variantView)
         {
-            // Set the size I need according to the number of elements inside the JSONValue
-            variantView.set_size(static_cast<size_t>(jsonArrayValue.Size()));
-            // 0 is int[i][i]
-            // 1 is getting int[i]
-            // 2 is int
-            // get_rank_type() is for when trying to retrieve array
-            const type arrayValueType = variantView.get_rank_type(0);
+            JSON_TRACE_TYPE(Write, variantView.get_type());
+            this->StartArray(variantView.get_size());
+            // Every element has the same type, so the dispatch table entry is looked up once for the whole array
+            const AtomicType elementAtomicType = GetAtomicType(variantView.get_value_type());
+            // Nested contiguous containers (std::vector<std::vector<float>>) are written straight out of their memory
+            const ContiguousContainer* elementContiguous = FindContiguousContainer(variantView.get_value_type());
+            const ReferenceType* elementReference = m_References != nullptr ? FindReferenceType(variantView.get_value_type()) : nullptr;
 
-            for (SizeType index = 0; index < jsonArrayValue.Size(); ++index)
+            // variantView can store containers/arithmetic/std::string/enums inside
+            // Those are actually copied over to variant, for e.g. I can std::vector<int> cat{1,2,3,4,5}
+            // And then i variant var = cat;
+            // Then variantView = var.create_variant_sequential_view();
+            // So this is how variantView came about, inside it will store a std::vector<int>.
+            size_t index = 0;
+            for (const variant& item : variantView)
             {
-                auto& jsonIndex=   jsonArrayValue[index];
-
-                // Check if is container
-                if (jsonIndex.IsArray())
+                if (elementReference != nullptr)
                 {
-                    // Retrieve the data at the specified index wrapped inside std::reference_wrapper<T> 
-                    auto arrayView = variantView.get_value(index).create_sequential_view();
-                    ReadArray(arrayView, jsonIndex);
+                    WriteReference(*elementReference, item);
                 }
-                else if (jsonIndex.IsObject())
+                else if (elementContiguous != nullptr && WriteContiguous(*elementContiguous, item))
                 {
-                    // Get the value at that particular index
-                    variant value = variantView.get_value(index);
-                    // Extract the wrapped value and copied it into a new variant
-                    variant wrappedValue = value.extract_wrapped_value();
-                    ReadFromJsonRecursively(wrappedValue, jsonIndex);
-                    variantView.set_value(index, wrappedValue);
+                    // Do nothing
+                }
+                // Check if the item inside is a sequential container
+                else if (item.is_sequential_container())
+                {
+                    // Recursively call this function to add the item in one by one using WriteAtomicTypes
+                    WriteArray(item.create_sequential_view());
                 }
                 else
                 {
-                    variant extractedValue = ReadAtomicTypes(jsonIndex);
-                    if (extractedValue.convert(arrayValueType))
+                    // A wrapper type is a class which encapsulate an instance of another type. This encapsulate type is also called wrapped type.
+                    variant wrappedVariant = item.extract_wrapped_value();
+                    type valueType = wrappedVariant.get_type();
+
+                    if (elementAtomicType != AtomicType::None && valueType == variantView.get_value_type())
+                    {
+                        WriteAtomic(elementAtomicType, wrappedVariant);
+                    }
+                    else if (valueType.is_arithmetic() || valueType == type::get<std::string>() || valueType.is_enumeration())
+                    {
+                        WriteAtomicTypes(valueType, wrappedVariant);
+                    }
+                    else
                     {
-                        variantView.set_value(index, extractedValue);
+                        // Is an object, object refers to your class/struct object
+                        const DiagnosticPathScope pathScope{ m_Path, index };
+                        WriteToJSONRecursively(wrappedVariant);
                     }
                 }
+                ++index;
             }
+            this->EndArray();
         }
 
-        void ReadAssociativeContainer(variant_associative_view& variantView, Value& jsonAssociativeValue)
+        void WriteAssociativeContainer(const variant_associative_view& variantView)
         {
-            for (SizeType i = 0; i < jsonAssociativeValue.Size(); ++i)
+            static const string_view key_name("key");
+            static const string_view value_name("value");
+            JSON_TRACE_TYPE(Write, variantView.get_type());
+
+            this->StartArray(variantView.get_size());
+            if (variantView.is_key_only_type())
             {
-                auto& jsonValue = jsonAssociativeValue[i];
+                for (const std::pair<variant, variant>& item : variantView)
+                {
+                    WriteVariant(item.first);
+                }
+            }
+            else
+            {
+                for (const std::pair<variant, variant>& item : variantView)
+                {
+                    this->StartObject();
 
-                // Key-Value pair value
-                if (jsonValue.IsObject())
+                    this->PutKey(key_name.data());
+                    WriteVariant(item.first);
+
+                    this->PutKey(value_name.data());
+                    WriteVariant(item.second);
+
+                    this->EndObject();
+                }
+            }
+            this->EndArray();
+        }
+
+        // {"$ref": id} of the object value points to, null for a null pointer
+        bool WriteReference(const ReferenceType& reference, const variant& value)
+        {
+            const void* address = reference.address(value);
+            if (address == nullptr)
+            {
+                this->PutNull();
+                return true;
+            }
+
+            this->StartObject();
+            this->PutKey("$ref");
+            m_Writer->Uint(m_References->GetId(address, reference));
+            this->EndObject();
+            return true;
+        }
+
+        bool WriteVariant(const variant& variant)
+        {
+            type valueType = variant.get_type();
+            JSON_TRACE_TYPE(Write, valueType);
+            type wrappedType = valueType.is_wrapper() ? valueType.get_wrapped_type() : valueType;
+            const bool isWrappedType = wrappedType != valueType;
+
+            if (m_References != nullptr)
+            {
+                // The pointer itself, or a std::reference_wrapper to it
+                const ReferenceType* reference = FindReferenceType(valueType);
+                reference = reference == nullptr && isWrappedType ? FindReferenceType(wrappedType) : reference;
+                if (reference != nullptr)
                 {
-                    Value::MemberIterator key = jsonValue.FindMember("key");
-                    Value::MemberIterator value = jsonValue.FindMember("value");
+                    return WriteReference(*reference, variant);
+                }
+            }
 
-                    if (key != jsonValue.MemberEnd() && value != jsonValue.MemberEnd())
-                    {
-                        auto keyValue = ReadValue(variantView.get_key_type(), key);
-                        auto valueValue = ReadValue(variantView.get_value_type(), value);
-                        if (keyValue && valueValue)
-                        {
-                            variantView.insert(keyValue, valueValue);
-                        }
-                    }
+            this->SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+            if (WriteAtomicTypes(isWrappedType ? wrappedType : valueType, isWrappedType ? variant.extract_wrapped_value() : variant))
+            {
+                // Do nothing
+            }
+            else if (variant.is_sequential_container())
+            {
+                // Write single line array when serializing a sequential container
+                this->SetFormatOptions(PrettyFormatOptions::kFormatSingleLineArray);
+                WriteArray(variant.create_sequential_view());
+            }
+            else if (variant.is_associative_container())
+            {
+                WriteAssociativeContainer(variant.create_associative_view());
+            }
+            else
+            {
+                const auto childProperties = isWrappedType ? wrappedType.get_properties() : valueType.get_properties();
+                if (!childProperties.empty())
+                {
+                    WriteToJSONRecursively(variant);
                 }
-                // Key only value
                 else
                 {
-                    variant extractedValue = ReadAtomicTypes(jsonValue);
-                    if (extractedValue && extractedValue.convert(variantView.get_key_type()))
+                    bool canConvertToString = false;
+                    const std::string value = variant.to_string(&canConvertToString);
+                    if (!canConvertToString)
                     {
-                        variantView.insert(extractedValue);
+                        this->PutKey(value);
+                        return false;
                     }
+                    this->PutKey(value);
                 }
             }
+            return true;
         }
 
-        void ReadFromJsonRecursively(instance rttrObject, Value& jsonObject)
+        // Same as WriteVariant, but the kind of value is already known from the plan
+        bool WritePropertyValue(const PropertyPlan& propertyPlan, const variant& propertyValue)
         {
-            // Variant Sequential View is your vector, deque, list etc..
-            // Variant Associative View is your map, unordered map
-            instance object = rttrObject.get_type().get_raw_type().is_wrapper() ? rttrObject.get_wrapped_instance() : rttrObject;
-            // Property are your variables that you reflect
-            const auto propertyList = object.get_derived_type().get_properties();
+            this->SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+            if (m_References != nullptr && propertyPlan.reference != nullptr)
+            {
+                return WriteReference(*propertyPlan.reference, propertyValue);
+            }
+            switch (propertyPlan.kind)
+            {
+            case PropertyKind::Atomic:
+            case PropertyKind::Enumeration:
+            {
+                const variant& value = propertyPlan.isWrapper ? propertyValue.extract_wrapped_value() : propertyValue;
+                return WriteAtomic(propertyPlan.atomicType, value) || WriteAtomicTypes(propertyPlan.valueType, value);
+            }
+            case PropertyKind::Sequential:
+                // Write single line array when serializing a sequential container
+                this->SetFormatOptions(PrettyFormatOptions::kFormatSingleLineArray);
+                if (propertyPlan.contiguous == nullptr || !WriteContiguous(*propertyPlan.contiguous, propertyValue))
+                {
+                    WriteArray(propertyValue.create_sequential_view());
+                }
+                return true;
+            case PropertyKind::Associative:
+                WriteAssociativeContainer(propertyValue.create_associative_view());
+                return true;
+            case PropertyKind::Object:
+            default:
+                return WriteVariant(propertyValue);
+            }
+        }
+
+        // Writes the whole object through the functions generated from its member list, false if this handler has none
+        bool WriteMemberList(const MemberListSerializer& memberList, const instance& obj)
+        {
+            const void* object = memberList.address(obj);
+            if (object == nullptr)
+            {
+                return false;
+            }
+
+            if constexpr (std::is_same_v<OutputHandler, PrettyWriter<OutputStream>>)
+                memberList.writePretty(*m_Writer, object);
+            else if constexpr (std::is_same_v<OutputHandler, rapidjson::Writer<OutputStream>>)
+                memberList.writeCompact(*m_Writer, object);
+            else if constexpr (std::is_same_v<OutputHandler, Binary::Encoder>)
+                memberList.writeBinary(*m_Writer, object);
+            else
+                return false;
+
+            // Writing a property puts the format back to default, do the same so the output matches the RTTR walk
+            this->SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+            return true;
+        }
+
+        void WriteToJSONRecursively(const instance& rttrObject)
+        {
+            instance obj = rttrObject.get_type().get_raw_type().is_wrapper() ? rttrObject.get_wrapped_instance() : rttrObject;
+            JSON_TRACE_TYPE(Write, obj.get_derived_type());
+
+            // Getting your derived class where the list will contain all your base type properties also
+            // The plan is built once per type, NO_SERIALIZE and the keys are already worked out
+            const TypePlan& plan = GetTypePlan(obj.get_derived_type());
+            if (plan.memberList != nullptr && WriteMemberList(*plan.memberList, obj))
+            {
+                return;
+            }
+
+            this->StartObject();
+            for (size_t index = 0; index < plan.properties.size(); ++index)
+            {
+                const PropertyPlan& propertyPlan = plan.properties[index];
+                // Skip properties that are marked NO_SERIALIZE
+                if (propertyPlan.noSerialize)
+                {
+                    continue;
+                }
+
+                variant propertyValue = propertyPlan.prop.get_value(obj);
+
+                if (!propertyValue)
+                {
+                    // Cannot serialize, because we cannot retrieve the value
+                    m_Path.Report(ErrorCode::PropertyNotReadable, propertyPlan.name, propertyPlan.valueType);
+                    continue;
+                }
+
+                JSON_TRACE_PROPERTY(Write, propertyPlan);
+                this->PutPropertyKey(propertyPlan, index);
+
+                const DiagnosticPathScope pathScope{ m_Path, std::string_view(propertyPlan.name) };
+                if (!WritePropertyValue(propertyPlan, propertyValue))
+                {
+                    m_Path.ReportCurrent(ErrorCode::PropertyNotWritten, propertyPlan.name, propertyPlan.valueType);
+                }
+            }
+
+            this->EndObject();
+        }
+
+        // Same layout as WriteToJSONRecursively, but only the properties of rttrObject that differ from the ones of baseline are written
+        // Objects that differ are written as deltas of their own, same sized sequential containers of objects element by element
+        // ({} for the elements that did not change), everything else that differs is written whole
+        void WriteDeltaRecursively(const instance& rttrObject, const instance& baseline)
+        {
+            instance obj = rttrObject.get_type().get_raw_type().is_wrapper() ? rttrObject.get_wrapped_instance() : rttrObject;
+            instance base = baseline.is_valid() && baseline.get_type().get_raw_type().is_wrapper() ? baseline.get_wrapped_instance() : baseline;
+
+            // Nothing to compare against, the whole object is the delta
+            if (!base.is_valid() || base.get_derived_type() != obj.get_derived_type())
+            {
+                WriteToJSONRecursively(obj);
+                return;
+            }
+
+            this->StartObject();
+            const TypePlan& plan = GetTypePlan(obj.get_derived_type());
+            for (size_t index = 0; index < plan.properties.size(); ++index)
+            {
+                const PropertyPlan& propertyPlan = plan.properties[index];
+                if (propertyPlan.noSerialize)
+                {
+                    continue;
+                }
+
+                variant propertyValue = propertyPlan.prop.get_value(obj);
+                if (!propertyValue)
+                {
+                    m_Path.Report(ErrorCode::PropertyNotReadable, propertyPlan.name, propertyPlan.valueType);
+                    continue;
+                }
+
+                const variant baselineValue = propertyPlan.prop.get_value(base);
+                if (baselineValue && ValuesEqual(propertyValue, baselineValue))
+                {
+                    continue;
+                }
+
+                this->PutPropertyKey(propertyPlan, index);
+
+                const DiagnosticPathScope pathScope{ m_Path, std::string_view(propertyPlan.name) };
+                if (!(baselineValue && WritePropertyDelta(propertyPlan, propertyValue, baselineValue)) && !WritePropertyValue(propertyPlan, propertyValue))
+                {
+                    m_Path.ReportCurrent(ErrorCode::PropertyNotWritten, propertyPlan.name, propertyPlan.valueType);
+                }
+            }
+            this->EndObject();
+        }
+
+        // Writes the delta of a property value that differs from baselineValue, false if the value has to be written whole instead
+        bool WritePropertyDelta(const PropertyPlan& propertyPlan, const variant& propertyValue, const variant& baselineValue)
+        {
+            if (propertyPlan.isWrapper || propertyValue.get_type() != baselineValue.get_type())
+            {
+                return false;
+            }
+
+            if (propertyPlan.kind == PropertyKind::Object && !propertyPlan.valueType.get_properties().empty())
+            {
+                this->SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+                WriteDeltaRecursively(propertyValue, baselineValue);
+                return true;
+            }
+
+            if (propertyPlan.kind != PropertyKind::Sequential || propertyPlan.contiguous != nullptr)
+            {
+                return false;
+            }
+
+            // The reader keeps the elements when the size does not change, so only their deltas are needed
+            const variant_sequential_view valueView = propertyValue.create_sequential_view();
+            const variant_sequential_view baselineView = baselineValue.create_sequential_view();
+            const type elementType = valueView.get_value_type();
+            if (valueView.get_size() != baselineView.get_size() || elementType.is_wrapper() || elementType.is_sequential_container() ||
+                elementType.is_associative_container() || elementType.get_properties().empty())
+            {
+                return false;
+            }
+
+            this->SetFormatOptions(PrettyFormatOptions::kFormatSingleLineArray);
+            this->StartArray(valueView.get_size());
+            for (size_t index = 0; index < valueView.get_size(); ++index)
+            {
+                WriteDeltaRecursively(valueView.get_value(index).extract_wrapped_value(), baselineView.get_value(index).extract_wrapped_value());
+            }
+            this->EndArray();
+            return true;
+        }
+        // *********************************************************
+
+        // *********************************************************
+        // *Getters for private members
+        // *********************************************************
+        OutputHandler* GetOutputHandler() const
+        {
+            return m_Writer;
+        }
+
+        // *********************************************************
+        // *Dispatch table for the atomic types, indexed by AtomicType
+        // *Every entry takes the value out of the variant as its real type, no to_int32/to_double round trips
+        // *********************************************************
+        using AtomicWriteFunction = void (*)(OutputHandler&, const variant&);
+
+        template <typename Type>
+        static void WriteNumber(OutputHandler& handler, Type number)
+        {
+            if constexpr (std::is_same_v<Type, bool> || std::is_same_v<Type, char>)
+                handler.Bool(number != 0);
+            else if constexpr (std::is_same_v<Type, float> && has_float<OutputHandler>::value)
+                handler.Float(number);
+            else if constexpr (std::is_floating_point_v<Type>)
+                handler.Double(static_cast<double>(number));
+            else if constexpr (std::is_signed_v<Type> && sizeof(Type) <= sizeof(int))
+                handler.Int(number);
+            else if constexpr (std::is_signed_v<Type>)
+                handler.Int64(number);
+            else if constexpr (sizeof(Type) <= sizeof(unsigned))
+                handler.Uint(number);
+            else
+                handler.Uint64(number);
+        }
+
+        template <typename Type>
+        static void WriteArithmetic(OutputHandler& handler, const variant& value)
+        {
+            WriteNumber(handler, value.get_value<Type>());
+        }
+
+        static void WriteString(OutputHandler& handler, const variant& value)
+        {
+            const std::string& string = value.get_value<std::string>();
+            handler.String(string.data(), static_cast<SizeType>(string.size()));
+        }
+
+        static void WriteCString(OutputHandler& handler, const variant& value)
+        {
+            const char* string = value.get_value<const char*>();
+            string ? handler.String(string) : handler.Null();
+        }
+
+        static void WriteEnumeration(OutputHandler& handler, const variant& value)
+        {
+            // Write the name if the value is registered, else the underlying number
+            const string_view name = value.get_type().get_enumeration().value_to_name(value);
+            if (!name.empty())
+            {
+                handler.String(name.data(), static_cast<SizeType>(name.size()));
+                return;
+            }
+
+            bool canConvertToNumber = false;
+            const uint64_t number = value.to_uint64(&canConvertToNumber);
+            canConvertToNumber ? handler.Uint64(number) : handler.Null();
+        }
+
+        static constexpr AtomicWriteFunction ATOMIC_WRITERS[] =
+        {
+            nullptr,                        // None
+            &WriteArithmetic<bool>,
+            &WriteArithmetic<char>,
+            &WriteArithmetic<int8_t>,
+            &WriteArithmetic<int16_t>,
+            &WriteArithmetic<int32_t>,
+            &WriteArithmetic<int64_t>,
+            &WriteArithmetic<uint8_t>,
+            &WriteArithmetic<uint16_t>,
+            &WriteArithmetic<uint32_t>,
+            &WriteArithmetic<uint64_t>,
+            &WriteArithmetic<float>,
+            &WriteArithmetic<double>,
+            &WriteString,
+            &WriteCString,
+            &WriteEnumeration
+        };
+        static_assert(std::size(ATOMIC_WRITERS) == static_cast<size_t>(AtomicType::Count), "ATOMIC_WRITERS has to match AtomicType");
+
+        // *********************************************************
+        // *Same for the elements of a contiguous container, one call writes all of them straight out of the container memory
+        // *********************************************************
+        using ContiguousWriteFunction = void (*)(OutputHandler&, const void*, size_t);
+
+        template <typename Type>
+        static void WriteNumbers(OutputHandler& handler, const void* data, size_t count)
+        {
+            const Type* numbers = static_cast<const Type*>(data);
+            for (size_t i = 0; i < count; ++i)
+            {
+                WriteNumber(handler, numbers[i]);
+            }
+        }
+
+        // Only the number types can be registered as a ContiguousContainer
+        static constexpr ContiguousWriteFunction CONTIGUOUS_WRITERS[] =
+        {
+            nullptr,                        // None
+            nullptr,                        // Bool
+            nullptr,                        // Char
+            &WriteNumbers<int8_t>,
+            &WriteNumbers<int16_t>,
+            &WriteNumbers<int32_t>,
+            &WriteNumbers<int64_t>,
+            &WriteNumbers<uint8_t>,
+            &WriteNumbers<uint16_t>,
+            &WriteNumbers<uint32_t>,
+            &WriteNumbers<uint64_t>,
+            &WriteNumbers<float>,
+            &WriteNumbers<double>,
+            nullptr,                        // String
+            nullptr,                        // CString
+            nullptr                         // Enumeration
+        };
+        static_assert(std::size(CONTIGUOUS_WRITERS) == static_cast<size_t>(AtomicType::Count), "CONTIGUOUS_WRITERS has to match AtomicType");
+
+    private:
+        // Private Variables
+        OutputHandler* m_Writer = nullptr;
+        ReferenceTable* m_References = nullptr;
+        // Only kept while a DiagnosticSink is set
+        DiagnosticPath m_Path;
+
+        // Private Functions
+        //TODO:: Multimap , Multiset not fully tested
+        template<typename Type, template<typename, typename...> class Container, typename... Containee>
+        void PutContainerValue(const Container<Type, Containee...>& valueContainer)
+        {
+            StartArray();
+            // When dealing with containers, I would want the JSON file to be in one line
+            SetFormatOptions(kFormatSingleLineArray);
+
+            if constexpr (TYPETRAITS::is_pair<std::decay_t<decltype(*valueContainer.begin())>>::value)
+            {
+                for (const auto& itr : valueContainer)
+                {
+                    // Safety Check for same Type, unable to StartObject for same type
+                    if (TYPETRAITS::are_same<Type, Containee...>::value)
+                    {
+                        PutKey(itr.first);
+                        PutValue(itr.second);
+                    }
+                    else
+                    {
+                        StartObject();
+                        PutKey(itr.first);
+                        PutValue(itr.second);
+                        EndObject();
+                    }
+                }
+            }
+            else
+            {
+                for (const auto& itr : valueContainer)
+                {
+                    PutValue(itr);
+                }
+            }
+            EndArray();
+        }
+
+        template<typename Function, typename Tuple>
+        void GetAllTupleElements(Function&& function, Tuple&& tuple)
+        {
+            std::apply([&function](auto&&... Args)
+                {
+                    (function(std::forward<decltype(Args)>(Args)), ...);
+                },
+                std::forward<Tuple>(tuple));
+        }
+
+        template<typename... Containee>
+        void PutContainerTuple(const std::tuple<Containee...>& valueContainer)
+        {
+            StartArray();
+            // When dealing with containers, I would want the JSON file to be in one line
+            SetFormatOptions(kFormatSingleLineArray);
+
+            GetAllTupleElements([&](auto&& Args)
+                {
+                    PutValue(Args);
+                }, valueContainer);
+
+            EndArray();
+        }
+    };
+
+    // Indented writer, used by SerializeBase and for debugging output
+    using Writer = GenericWriter<PrettyWriter<OutputStream>>;
+    // Whitespace free writer, used for production saves
+    using CompactWriter = GenericWriter<rapidjson::Writer<OutputStream>>;
+
+    // *********************************************************
+    // *Everything a save into memory allocates, kept alive between saves so repeated small saves (network messages, undo snapshots) stop allocating
+    // *The output string, the write buffer and the level stacks of both rapidjson writers keep their capacity, Begin only rewinds them
+    // *The string_view handed out points into the context and is only valid until the next save through the same context
+    // *One context per thread
+    // *********************************************************
+    class SerializationContext
+    {
+    public:
+        SerializationContext() :
+            m_WriteBuffer{ new char[WRITE_BUFFER_SIZE] },
+            m_Stream{ m_Output, m_WriteBuffer.get(), WRITE_BUFFER_SIZE },
+            m_PrettyWriter{ m_Stream },
+            m_CompactWriter{ m_Stream }
+        {
+        }
+
+        // Not copyable, the stream and the writers point into the context
+        SerializationContext(const SerializationContext&) = delete;
+        SerializationContext& operator=(const SerializationContext&) = delete;
+
+        // Drops the previous output and rewinds the stream and the writers, nothing is freed
+        void Begin()
+        {
+            m_Output.clear();
+            m_Stream.Reset();
+            m_PrettyWriter.Reset(m_Stream);
+            // Reset keeps the format options, a save that ended in a single line array would pass it on to the next one
+            m_PrettyWriter.SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+            m_CompactWriter.Reset(m_Stream);
+        }
+
+        // Everything written since Begin
+        std::string_view End()
+        {
+            m_Stream.Flush();
+            return m_Output;
+        }
+
+        OutputStream& GetStream()
+        {
+            return m_Stream;
+        }
+
+        PrettyWriter<OutputStream>& GetPrettyWriter()
+        {
+            return m_PrettyWriter;
+        }
+
+        rapidjson::Writer<OutputStream>& GetCompactWriter()
+        {
+            return m_CompactWriter;
+        }
+
+    private:
+        std::string m_Output;
+        std::unique_ptr<char[]> m_WriteBuffer;
+        OutputStream m_Stream;
+        PrettyWriter<OutputStream> m_PrettyWriter;
+        rapidjson::Writer<OutputStream> m_CompactWriter;
+    };
+
+    class Reader
+    {
+    public:
+        // Default Constructor
+        Reader() = default;
+
+        // Parametrized Constructor
+        Reader(Value& data) : m_Data{ &data }
+        {
+        }
+
+        bool IsNull() const
+        {
+            return m_Data->IsNull();
+        }
+
+        bool IsObject() const
+        {
+            return m_Data->IsObject();
+        }
+
+        bool IsArray() const
+        {
+            return m_Data->IsArray();
+        }
+
+        bool HasMember(const std::string& name) const
+        {
+            return m_Data->HasMember(name.c_str());
+        }
+
+        // More optimized version compared to HasMember where it perform 1 seek instead of 2 seeks
+        // Please use this
+        GenericValue<UTF8<>>::MemberIterator FindMember(const std::string& name) const
+        {
+            // Checking through the array if this member exist,
+            // Return false if it reaches the end with no result
+            return m_Data->FindMember(name.c_str());
+        }
+
+        Value& ReadRawValue(const std::string& Key) const
+        {
+            return (*m_Data)[Key.c_str()];
+        }
+
+        template <typename TValue>
+        TValue ReadValue(const std::string& Key)
+        {
+            // Check if the key given is valid
+            if (m_Data->FindMember(Key.c_str()) == m_Data->MemberEnd())
+            {
+                ReportDiagnostic(ErrorCode::MissingKey, Key);
+                return TValue{};
+            }
+
+            const Value& value = (*m_Data)[Key.c_str()];
+
+            if constexpr (TYPETRAITS::are_same<TValue, uint64_t>::value)
+                return value.GetUint64();
+            if constexpr (TYPETRAITS::are_same<TValue, int64_t>::value)
+                return value.GetInt64();
+            if constexpr (TYPETRAITS::are_same<TValue, double>::value)
+                return value.GetDouble();
+            if constexpr (TYPETRAITS::are_same<TValue, float>::value)
+                return value.GetFloat();
+            if constexpr (TYPETRAITS::are_same<TValue, bool>::value)
+                return value.GetBool();
+            if constexpr (TYPETRAITS::are_same<TValue, int>::value)
+                return value.GetInt();
+            if constexpr (TYPETRAITS::are_same<TValue, unsigned>::value)
+                return value.GetUint();
+            if constexpr (TYPETRAITS::are_same<TValue, std::string>::value || TYPETRAITS::are_same<TValue, const char*>::value)
+                return value.GetString();
+
+            ReportDiagnostic(ErrorCode::UnsupportedType, Key);
+            return TValue{};
+        }
+
+        template <typename T, typename... TValue, typename Encoding, typename Allocator = RAPIDJSON_DEFAULT_ALLOCATOR>
+        T ReadValue(const GenericValue<Encoding, Allocator>& Value)
+        {
+            if constexpr (TYPETRAITS::are_same<T, uint64_t>::value)
+                return Value.GetUint64();
+            if constexpr (TYPETRAITS::are_same<T, int64_t>::value)
+                return Value.GetInt64();
+            if constexpr (TYPETRAITS::are_same<T, double>::value)
+                return Value.GetDouble();
+            if constexpr (TYPETRAITS::are_same<T, float>::value)
+                return Value.GetFloat();
+            if constexpr (TYPETRAITS::are_same<T, bool>::value)
+                return Value.GetBool();
+            if constexpr (TYPETRAITS::are_same<T, int>::value)
+                return Value.GetInt();
+            if constexpr (TYPETRAITS::are_same<T, unsigned>::value)
+                return Value.GetUint();
+            if constexpr (TYPETRAITS::are_same<T, std::string>::value || TYPETRAITS::are_same<T, const char*>::value)
+                return Value.GetString();
+
+            ReportDiagnostic(ErrorCode::UnsupportedType);
+            return T{};
+        }
+
+        template<typename Type, template<typename, typename...> class Container, typename... Containee>
+        void ReadContainerValue(Container<Type, Containee...>& valueContainer, const std::string& Key)
+        {
+            // Check if the key given is valid
+            if (m_Data->FindMember(Key.c_str()) == m_Data->MemberEnd())
+            {
+                ReportDiagnostic(ErrorCode::MissingKey, Key);
+                return;
+            }
+
+            const Value& data = (*m_Data)[Key.c_str()];
+
+            // Check if container contains pair -> map, multimap, unordered map...
+            if constexpr (TYPETRAITS::is_pair<std::decay_t<decltype(*valueContainer.begin())>>::value)
+            {
+                // Check if m_Data is null
+                if (IsNull())
+                {
+                    ReportDiagnostic(ErrorCode::UnexpectedLayout, "m_Data is null");
+                    return;
+                }
+
+                if (data.IsArray())
+                {
+                    for (const auto& itr : data.GetArray())
+                    {
+                        if (itr.IsObject())
+                        {
+                            for (auto m = itr.MemberBegin(); m != itr.MemberEnd(); ++m)
+                            {
+                                const std::string key = m->name.GetString();
+                                auto value = ReadValue<Containee...>(m->value);
+                                valueContainer.emplace(std::make_pair(key, value));
+                            }
+                        }
+                    }
+                }
+            }
+            // This is vector, deque, set, list...
+            else
+            {
+                if (data.IsArray())
+                {
+                    for (SizeType i = 0; i < data.Size(); ++i)
+                    {
+                        valueContainer.push_back(ReadValue<Type>(data[i]));
+                    }
+                }
+            }
+        }
+
+        // TODO:: WIP
+        template<typename Type, template<typename, typename...> class Container, typename... Containee>
+        void ReadTupleValue(Container<Type, Containee...>& valueContainer, const std::string& Key)
+        {
+            //const Value& data = (*m_Data)[Key.c_str()];
+
+            //if (data.IsArray())
+            //{
+            //    for (SizeType i = 0; i < data.Size(); ++i)
+            //    {
+            //        std::cout << GetValue<Containee...>(data[i]) << std::endl;
+            //    }
+
+            //    //auto tupleSize = std::tuple_size<decltype(valueContainer)>::value;
+            //    //std::cout << tupleSize << std::endl;
+            //}
+        }
+
+
+        // *********************************************************
+        // *Using RTTR Library API to help retrieve the value + type from JSON value as a form of variant(rttr variant class which can be used for any type)
+        // *********************************************************
+
+        // *********************************************************
+        // *Dispatch tables for the atomic types, indexed by AtomicType
+        // *Every entry reads the JSON value as the real type of the target and sets it, no variant + convert in between
+        // *They return false if the JSON value is not an exact fit, the caller then falls back to ReadAtomicTypes + convert
+        // *********************************************************
+        using AtomicPropertyReadFunction = bool (*)(const property&, instance&, const Value&);
+        using AtomicElementReadFunction = bool (*)(variant_sequential_view&, size_t, const Value&);
+
+        template <typename Type>
+        static bool ReadAtomicValue(const Value& jsonValue, Type& value)
+        {
+            // char is written as a bool
+            if constexpr (std::is_same_v<Type, bool> || std::is_same_v<Type, char>)
+            {
+                if (!jsonValue.IsBool())
+                    return false;
+                value = static_cast<Type>(jsonValue.GetBool());
+            }
+            else if constexpr (std::is_floating_point_v<Type>)
+            {
+                if (!jsonValue.IsNumber())
+                    return false;
+                // A double past the range of float is left to convert, the cast would be undefined
+                if (std::fabs(jsonValue.GetDouble()) > static_cast<double>(std::numeric_limits<Type>::max()))
+                    return false;
+                value = static_cast<Type>(jsonValue.GetDouble());
+            }
+            else if constexpr (std::is_signed_v<Type>)
+            {
+                if (!jsonValue.IsInt64())
+                    return false;
+                const int64_t number = jsonValue.GetInt64();
+                // Out of range is left to convert, which refuses it
+                if (number < std::numeric_limits<Type>::min() || number > std::numeric_limits<Type>::max())
+                    return false;
+                value = static_cast<Type>(number);
+            }
+            else if constexpr (std::is_unsigned_v<Type>)
+            {
+                if (!jsonValue.IsUint64())
+                    return false;
+                const uint64_t number = jsonValue.GetUint64();
+                if (number > std::numeric_limits<Type>::max())
+                    return false;
+                value = static_cast<Type>(number);
+            }
+            else
+            {
+                if (!jsonValue.IsString())
+                    return false;
+                value.assign(jsonValue.GetString(), jsonValue.GetStringLength());
+            }
+            return true;
+        }
+
+        static variant ReadEnumerationValue(const type& enumType, const Value& jsonValue)
+        {
+            if (!jsonValue.IsString())
+            {
+                return variant();
+            }
+            return enumType.get_enumeration().name_to_value(string_view(jsonValue.GetString(), jsonValue.GetStringLength()));
+        }
+
+        template <typename Type>
+        static bool ReadAtomicProperty(const property& prop, instance& object, const Value& jsonValue)
+        {
+            Type value{};
+            return ReadAtomicValue(jsonValue, value) && prop.set_value(object, value);
+        }
+
+        static bool ReadEnumerationProperty(const property& prop, instance& object, const Value& jsonValue)
+        {
+            const variant value = ReadEnumerationValue(prop.get_type(), jsonValue);
+            return value.is_valid() && prop.set_value(object, value);
+        }
+
+        template <typename Type>
+        static bool ReadAtomicElement(variant_sequential_view& view, size_t index, const Value& jsonValue)
+        {
+            Type value{};
+            return ReadAtomicValue(jsonValue, value) && view.set_value(index, value);
+        }
+
+        static bool ReadEnumerationElement(variant_sequential_view& view, size_t index, const Value& jsonValue)
+        {
+            const variant value = ReadEnumerationValue(view.get_value_type(), jsonValue);
+            return value.is_valid() && view.set_value(index, value);
+        }
+
+        // const char* has no entry, there is nothing to point it at
+        static constexpr AtomicPropertyReadFunction ATOMIC_PROPERTY_READERS[] =
+        {
+            nullptr,                            // None
+            &ReadAtomicProperty<bool>,
+            &ReadAtomicProperty<char>,
+            &ReadAtomicProperty<int8_t>,
+            &ReadAtomicProperty<int16_t>,
+            &ReadAtomicProperty<int32_t>,
+            &ReadAtomicProperty<int64_t>,
+            &ReadAtomicProperty<uint8_t>,
+            &ReadAtomicProperty<uint16_t>,
+            &ReadAtomicProperty<uint32_t>,
+            &ReadAtomicProperty<uint64_t>,
+            &ReadAtomicProperty<float>,
+            &ReadAtomicProperty<double>,
+            &ReadAtomicProperty<std::string>,
+            nullptr,                            // CString
+            &ReadEnumerationProperty
+        };
+        static_assert(std::size(ATOMIC_PROPERTY_READERS) == static_cast<size_t>(AtomicType::Count), "ATOMIC_PROPERTY_READERS has to match AtomicType");
+
+        static constexpr AtomicElementReadFunction ATOMIC_ELEMENT_READERS[] =
+        {
+            nullptr,                            // None
+            &ReadAtomicElement<bool>,
+            &ReadAtomicElement<char>,
+            &ReadAtomicElement<int8_t>,
+            &ReadAtomicElement<int16_t>,
+            &ReadAtomicElement<int32_t>,
+            &ReadAtomicElement<int64_t>,
+            &ReadAtomicElement<uint8_t>,
+            &ReadAtomicElement<uint16_t>,
+            &ReadAtomicElement<uint32_t>,
+            &ReadAtomicElement<uint64_t>,
+            &ReadAtomicElement<float>,
+            &ReadAtomicElement<double>,
+            &ReadAtomicElement<std::string>,
+            nullptr,                            // CString
+            &ReadEnumerationElement
+        };
+        static_assert(std::size(ATOMIC_ELEMENT_READERS) == static_cast<size_t>(AtomicType::Count), "ATOMIC_ELEMENT_READERS has to match AtomicType");
+
+        // *********************************************************
+        // *Same for the elements of a contiguous container, one call reads a run of JSON values straight into the container memory
+        // *********************************************************
+        using ContiguousReadFunction = void (*)(void*, const Value*, size_t);
+
+        // False if number is out of the range of Type (or NaN), static_cast would be undefined then
+        template <typename Type>
+        static bool IsInRange(double number)
+        {
+            if constexpr (std::is_integral_v<Type>)
+            {
+                // 2^digits is exact as a double, unlike numeric_limits<Type>::max() for 64 bit types
+                const double limit = std::ldexp(1.0, std::numeric_limits<Type>::digits);
+                return std::is_signed_v<Type> ? number >= -limit && number < limit : number > -1.0 && number < limit;
+            }
+            else
+            {
+                return number >= -static_cast<double>(std::numeric_limits<Type>::max()) && number <= static_cast<double>(std::numeric_limits<Type>::max());
+            }
+        }
+
+        template <typename Type>
+        static void ReadNumbers(void* data, const Value* jsonValues, size_t count)
+        {
+            Type* numbers = static_cast<Type*>(data);
+            for (size_t i = 0; i < count; ++i)
+            {
+                // Numbers that do not fit exactly (1.5 into an int) are truncated like variant::convert would
+                // Values that are not numbers or do not fit at all are skipped, the element keeps its value like in ReadElement
+                if (!ReadAtomicValue(jsonValues[i], numbers[i]) && jsonValues[i].IsNumber() && IsInRange<Type>(jsonValues[i].GetDouble()))
+                {
+                    numbers[i] = static_cast<Type>(jsonValues[i].GetDouble());
+                }
+            }
+        }
+
+        // Only the number types can be registered as a ContiguousContainer
+        static constexpr ContiguousReadFunction CONTIGUOUS_READERS[] =
+        {
+            nullptr,                            // None
+            nullptr,                            // Bool
+            nullptr,                            // Char
+            &ReadNumbers<int8_t>,
+            &ReadNumbers<int16_t>,
+            &ReadNumbers<int32_t>,
+            &ReadNumbers<int64_t>,
+            &ReadNumbers<uint8_t>,
+            &ReadNumbers<uint16_t>,
+            &ReadNumbers<uint32_t>,
+            &ReadNumbers<uint64_t>,
+            &ReadNumbers<float>,
+            &ReadNumbers<double>,
+            nullptr,                            // String
+            nullptr,                            // CString
+            nullptr                             // Enumeration
+        };
+        static_assert(std::size(CONTIGUOUS_READERS) == static_cast<size_t>(AtomicType::Count), "CONTIGUOUS_READERS has to match AtomicType");
+
+        // Resizes the contiguous container held by value once and reads jsonArrayValue into its memory, returns false if value does not hold it
+        static bool ReadContiguous(const ContiguousContainer& container, variant& value, const Value& jsonArrayValue)
+        {
+            void* data = nullptr;
+            size_t count = 0;
+            if (!container.resize(value, static_cast<size_t>(jsonArrayValue.Size()), data, count))
+            {
+                return false;
+            }
+
+            // A fixed size container only takes what fits
+            CONTIGUOUS_READERS[static_cast<size_t>(container.elementType)](data, jsonArrayValue.Begin(), std::min(count, static_cast<size_t>(jsonArrayValue.Size())));
+            return true;
+        }
+
+        // Variant class allows us to store any type, and it is able to convert the type you want transparently
+        static variant ReadAtomicTypes(const Value& jsonValue)
+        {
+            switch (jsonValue.GetType())
+            {
+            case kNullType:
+                break;
+            case kFalseType:
+            case kTrueType:
+                return jsonValue.GetBool();
+            case kObjectType:
+            case kArrayType:
+                return variant();
+            case kStringType:
+                return std::string(jsonValue.GetString(), jsonValue.GetStringLength());
+            case kNumberType:
+            {
+                if (jsonValue.IsInt())
+                    return jsonValue.GetInt();
+                if (jsonValue.IsUint())
+                    return jsonValue.GetUint();
+                if (jsonValue.IsInt64())
+                    return jsonValue.GetInt64();
+                if (jsonValue.IsUint64())
+                    return jsonValue.GetUint64();
+                if (jsonValue.IsFloat())
+                    return jsonValue.GetFloat();
+                if (jsonValue.IsDouble())
+                    return jsonValue.GetDouble();
+                break;
+            }
+            }
+            return variant();
+        }
+
+        // Default constructed value of ArgType, held by value in the variant (not a pointer)
+        static variant CreateValue(const type& ArgType)
+        {
+            // Returns a public constructor whose parameters match the types in the specified list, else return default constructor
+            constructor ctor = ArgType.get_constructor();
+
+            for (const constructor& item : ArgType.get_constructors())
+            {
+                // If the item type is the same as ArgType, make the constructor to return the type I want
+                if (item.get_instantiated_type() == ArgType)
+                {
+                    ctor = item;
+                }
+            }
+            // Invokes the constructor of type returned by get_instantiated_type()
+            // Need to invoke constructor to get my variant object
+            // Thats why I checked whether the item is same type as ArgType
+            return ctor.invoke();
+        }
+
+        // Read the all the values that should be extracted out from the JSON Value
+        variant ReadValue(const type& ArgType, Value::MemberIterator& itr)
+        {
+            return ReadValue(ArgType, itr->value);
+        }
+
+        // A new value of ArgType made from jsonValue, invalid if jsonValue does not fit ArgType
+        variant ReadValue(const type& ArgType, Value& jsonValue)
+        {
+            if (m_References != nullptr)
+            {
+                if (const ReferenceType* reference = FindReferenceType(ArgType))
+                {
+                    return ReadReference(*reference, jsonValue);
+                }
+            }
+
+            variant extractedValue = ReadAtomicTypes(jsonValue);
+
+            // Check if the value we got from JSON can be converted to the type passed in
+            bool canConvertAtomicValueToType = extractedValue.can_convert(ArgType);
+
+            if (canConvertAtomicValueToType)
+            {
+                canConvertAtomicValueToType = extractedValue.convert(ArgType);
+            }
+
+            if (!canConvertAtomicValueToType)
+            {
+                if (jsonValue.IsObject())
+                {
+                    extractedValue = CreateValue(ArgType);
+                    ReadFromJsonRecursively(extractedValue, jsonValue);
+                }
+            }
+            return extractedValue;
+        }
+
+        // Reads a scalar JSON value into variantView[index], through the dispatch table when the JSON value fits exactly
+        // False if the value does not fit the element, the element is left as it is
+        static bool ReadScalarElement(variant_sequential_view& variantView, size_t index, AtomicElementReadFunction readElement, const type& arrayValueType, const Value& jsonValue)
+        {
+            if (readElement != nullptr && readElement(variantView, index, jsonValue))
+            {
+                return true;
+            }
+
+            variant extractedValue = ReadAtomicTypes(jsonValue);
+            return extractedValue.convert(arrayValueType) && variantView.set_value(index, extractedValue);
+        }
+
+        // Reads a scalar JSON value into the property, through the dispatch table when the JSON value fits exactly
+        // False if the value does not fit the property, the property is left as it is
+        static bool ReadScalarProperty(instance& object, const PropertyPlan& propertyPlan, const Value& jsonValue)
+        {
+            const property& propertie = propertyPlan.prop;
+
+            // Wrapped properties have to go through variant
+            const AtomicPropertyReadFunction readProperty = propertyPlan.isWrapper ? nullptr : ATOMIC_PROPERTY_READERS[static_cast<size_t>(propertyPlan.atomicType)];
+            if (readProperty != nullptr && readProperty(propertie, object, jsonValue))
+            {
+                return true;
+            }
+
+            variant extractedValue = ReadAtomicTypes(jsonValue);
+            // REMARK: CONVERSION WORKS ONLY WITH "const type", check whether this is correct or not!
+            return extractedValue.convert(propertie.get_type()) && propertie.set_value(object, extractedValue);
+        }
+
+        void ReadArray(variant_sequential_view& variantView, Value& jsonArrayValue)
+        {
+            JSON_TRACE_TYPE(Read, variantView.get_type());
+            // Set the size I need according to the number of elements inside the JSONValue
+            variantView.set_size(static_cast<size_t>(jsonArrayValue.Size()));
+            // Type of the elements, get_rank_type(0) would be the container type itself
+            const type arrayValueType = variantView.get_value_type();
+            // Every element has the same type, so the dispatch table entry is looked up once for the whole array
+            const AtomicElementReadFunction readElement = ATOMIC_ELEMENT_READERS[static_cast<size_t>(GetAtomicType(arrayValueType))];
+            // Nested contiguous containers (std::vector<std::vector<float>>) are read straight into their memory
+            const ContiguousContainer* elementContiguous = FindContiguousContainer(arrayValueType);
+            const ReferenceType* elementReference = m_References != nullptr ? FindReferenceType(arrayValueType) : nullptr;
+
+            for (SizeType index = 0; index < jsonArrayValue.Size(); ++index)
+            {
+                const DiagnosticPathScope pathScope{ m_Path, static_cast<size_t>(index) };
+                if (elementReference != nullptr)
+                {
+                    ReadReferenceElement(variantView, index, *elementReference, jsonArrayValue[index]);
+                    continue;
+                }
+                ReadElement(variantView, index, jsonArrayValue[index], readElement, elementContiguous, arrayValueType);
+            }
+        }
+
+        // Reads jsonIndex into variantView[index], the lookups for the element type are done once per array by ReadArray
+        void ReadElement(variant_sequential_view& variantView, size_t index, Value& jsonIndex, AtomicElementReadFunction readElement,
+            const ContiguousContainer* elementContiguous, const type& arrayValueType)
+        {
+            // Check if is container
+            if (jsonIndex.IsArray())
+            {
+                // Retrieve the data at the specified index wrapped inside std::reference_wrapper<T> 
+                variant element = variantView.get_value(index);
+                if (elementContiguous == nullptr || !ReadContiguous(*elementContiguous, element, jsonIndex))
+                {
+                    auto arrayView = element.create_sequential_view();
+                    ReadArray(arrayView, jsonIndex);
+                }
+            }
+            else if (jsonIndex.IsObject())
+            {
+                // Get the value at that particular index
+                variant value = variantView.get_value(index);
+                // Extract the wrapped value and copied it into a new variant
+                variant wrappedValue = value.extract_wrapped_value();
+                ReadFromJsonRecursively(wrappedValue, jsonIndex);
+                variantView.set_value(index, wrappedValue);
+            }
+            else if (!ReadScalarElement(variantView, index, readElement, arrayValueType, jsonIndex))
+            {
+                m_Path.ReportCurrent(ErrorCode::ValueMismatch, std::string_view(), arrayValueType);
+            }
+        }
+
+        // Same as above for a single element, does the lookups itself
+        void ReadElement(variant_sequential_view& variantView, size_t index, Value& jsonValue)
+        {
+            const type arrayValueType = variantView.get_value_type();
+            if (m_References != nullptr)
+            {
+                if (const ReferenceType* reference = FindReferenceType(arrayValueType))
+                {
+                    ReadReferenceElement(variantView, index, *reference, jsonValue);
+                    return;
+                }
+            }
+            ReadElement(variantView, index, jsonValue, ATOMIC_ELEMENT_READERS[static_cast<size_t>(GetAtomicType(arrayValueType))],
+                FindContiguousContainer(arrayValueType), arrayValueType);
+        }
+
+        void ReadAssociativeContainer(variant_associative_view& variantView, Value& jsonAssociativeValue)
+        {
+            JSON_TRACE_TYPE(Read, variantView.get_type());
+            // A delta holds the whole container, merging it into the one from the baseline would keep the old values of its keys
+            if (m_ReplaceAssociative)
+            {
+                variantView.clear();
+            }
+
+            for (SizeType i = 0; i < jsonAssociativeValue.Size(); ++i)
+            {
+                auto& jsonValue = jsonAssociativeValue[i];
+
+                // Key-Value pair value
+                if (jsonValue.IsObject())
+                {
+                    Value::MemberIterator key = jsonValue.FindMember("key");
+                    Value::MemberIterator value = jsonValue.FindMember("value");
+
+                    if (key != jsonValue.MemberEnd() && value != jsonValue.MemberEnd())
+                    {
+                        auto keyValue = ReadValue(variantView.get_key_type(), key);
+                        auto valueValue = ReadValue(variantView.get_value_type(), value);
+                        if (keyValue && valueValue)
+                        {
+                            variantView.insert(keyValue, valueValue);
+                        }
+                    }
+                }
+                // Key only value
+                else
+                {
+                    variant extractedValue = ReadAtomicTypes(jsonValue);
+                    if (extractedValue && extractedValue.convert(variantView.get_key_type()))
+                    {
+                        variantView.insert(extractedValue);
+                    }
+                }
+            }
+        }
+
+        // Pointer of reference's type to the object {"$ref": id} names, a null pointer for null, invalid for anything else
+        variant ReadReference(const ReferenceType& reference, const Value& jsonValue) const
+        {
+            if (jsonValue.IsNull())
+            {
+                return reference.make(std::shared_ptr<void>());
+            }
+
+            const Value::ConstMemberIterator id = jsonValue.IsObject() ? jsonValue.FindMember("$ref") : jsonValue.MemberEnd();
+            if (!jsonValue.IsObject() || id == jsonValue.MemberEnd() || !id->value.IsUint())
+            {
+                return variant();
+            }
+            return m_References->MakePointer(id->value.GetUint(), reference);
+        }
+
+        void ReadReferenceElement(variant_sequential_view& variantView, size_t index, const ReferenceType& reference, const Value& jsonValue) const
+        {
+            const variant pointer = ReadReference(reference, jsonValue);
+            if (pointer.is_valid())
+            {
+                variantView.set_value(index, pointer);
+            }
+        }
+
+        // Reads jsonValue into the property described by propertyPlan
+        void ReadProperty(instance& object, const PropertyPlan& propertyPlan, Value& jsonValue)
+        {
+            JSON_TRACE_PROPERTY(Read, propertyPlan);
+            const property& propertie = propertyPlan.prop;
+            if (m_References != nullptr && propertyPlan.reference != nullptr)
+            {
+                const variant pointer = ReadReference(*propertyPlan.reference, jsonValue);
+                if (pointer.is_valid())
+                {
+                    propertie.set_value(object, pointer);
+                }
+                return;
+            }
+            const type valueType = propertie.get_type();
+            switch (jsonValue.GetType())
+            {
+                case kArrayType:
+                {
+                    variant value;
+                    if (propertyPlan.contiguous != nullptr)
+                    {
+                        value = propertie.get_value(object);
+                        if (!ReadContiguous(*propertyPlan.contiguous, value, jsonValue))
+                        {
+                            variant_sequential_view sequentialView = value.create_sequential_view();
+                            ReadArray(sequentialView, jsonValue);
+                        }
+                    }
+                    else if (valueType.is_sequential_container())
+                    {
+                        value = propertie.get_value(object);
+                        variant_sequential_view sequentialView = value.create_sequential_view();
+                        ReadArray(sequentialView, jsonValue);
+                    }
+                    else if (valueType.is_associative_container())
+                    {
+                        value = propertie.get_value(object);
+                        variant_associative_view associative_view = value.create_associative_view();
+                        ReadAssociativeContainer(associative_view, jsonValue);
+                    }
+                    propertie.set_value(object, value);
+                    break;
+                }
+                case kObjectType:
+                {
+                    variant value = propertie.get_value(object);
+                    ReadFromJsonRecursively(value, jsonValue);
+                    propertie.set_value(object, value);
+                    break;
+                }
+                default:
+                {
+                    if (!ReadScalarProperty(object, propertyPlan, jsonValue))
+                    {
+                        m_Path.Report(ErrorCode::ValueMismatch, propertyPlan.name, propertyPlan.valueType);
+                    }
+                }
+            }
+        }
+
+        void ReadFromJsonRecursively(instance rttrObject, Value& jsonObject)
+        {
+            if (!jsonObject.IsObject())
+            {
+                return;
+            }
+
+            // Variant Sequential View is your vector, deque, list etc..
+            // Variant Associative View is your map, unordered map
+            instance object = rttrObject.get_type().get_raw_type().is_wrapper() ? rttrObject.get_wrapped_instance() : rttrObject;
+            JSON_TRACE_TYPE(Read, object.get_derived_type());
+            // Property are your variables that you reflect
+            const TypePlan& plan = GetTypePlan(object.get_derived_type());
+            if (plan.memberList != nullptr)
+            {
+                if (void* address = plan.memberList->address(object))
+                {
+                    plan.memberList->read(address, jsonObject);
+                    return;
+                }
+            }
+
+            // Go through the JSON members once, each member finds its property through the plan's perfect hash
+            for (Value::MemberIterator member = jsonObject.MemberBegin(); member != jsonObject.MemberEnd(); ++member)
+            {
+                // Skip members that are not a property of this type
+                const PropertyPlan* propertyPlan = plan.FindProperty(member->name.GetString(), member->name.GetStringLength());
+                if (propertyPlan == nullptr)
+                {
+                    continue;
+                }
+
+                if (member->value.IsObject() || member->value.IsArray())
+                {
+                    const DiagnosticPathScope pathScope{ m_Path, std::string_view(propertyPlan->name) };
+                    ReadProperty(object, *propertyPlan, member->value);
+                    continue;
+                }
+                ReadProperty(object, *propertyPlan, member->value);
+            }
+        }
+
+        Value& GetValueData() const
+        {
+            return *m_Data;
+        }
+
+        // Associative containers in the JSON replace the ones on the object instead of being merged into them, used to apply deltas
+        void SetReplaceAssociative(bool replaceAssociative)
+        {
+            m_ReplaceAssociative = replaceAssociative;
+        }
+
+        // Registered pointers are read from {"$ref": id} into the objects of references, nullptr turns it off
+        void SetReferences(const ReferenceTable* references)
+        {
+            m_References = references;
+        }
+
+    private:
+        Value* m_Data = nullptr;
+        bool m_ReplaceAssociative = false;
+        const ReferenceTable* m_References = nullptr;
+        // Only kept while a DiagnosticSink is set
+        DiagnosticPath m_Path;
+    };
+
+    // *********************************************************
+    // *SAX handler for rapidjson::Reader that sets the values on the RTTR instance as the tokens arrive, no Document is built
+    // *Keeps one frame per open JSON object/array, so memory grows with the nesting depth and not with the document size
+    // *Understands the same layout the Writer emits: objects, sequential containers and [{"key":..,"value":..}] associative containers
+    // *Binary::Decoder drives it as well, with PropertyId in place of Key
+    // *Members that are not a property, and values that do not fit their property, are skipped like Reader does
+    // *********************************************************
+    class SaxReader
+    {
+    public:
+        SaxReader(instance rttrObject) :
+            m_Root{ rttrObject.get_type().get_raw_type().is_wrapper() ? rttrObject.get_wrapped_instance() : rttrObject }
+        {
+        }
+
+        // Only true once the root object has been closed
+        bool IsComplete() const
+        {
+            return m_Complete;
+        }
+
+        // *********************************************************
+        // *rapidjson::Reader handler functions, every scalar is wrapped in a non owning Value so Reader's dispatch tables can be reused
+        // *********************************************************
+        bool Null()                             { return ReadScalar(Value()); }
+        bool Bool(bool value)                   { return ReadScalar(Value(value)); }
+        bool Int(int value)                     { return ReadScalar(Value(value)); }
+        bool Uint(unsigned value)               { return ReadScalar(Value(value)); }
+        bool Int64(int64_t value)               { return ReadScalar(Value(value)); }
+        bool Uint64(uint64_t value)             { return ReadScalar(Value(value)); }
+        bool Double(double value)               { return ReadScalar(Value(value)); }
+        bool String(const char* string, SizeType length, bool)
+        {
+            return ReadScalar(Value(StringRef(string, length)));
+        }
+        // Only called with kParseNumbersAsStringsFlag, which is not used
+        bool RawNumber(const char* string, SizeType length, bool copy)
+        {
+            return String(string, length, copy);
+        }
+
+        bool StartObject()
+        {
+            if (m_SkipDepth > 0 || m_Complete)
+            {
+                ++m_SkipDepth;
+                return true;
+            }
+
+            if (m_Frames.empty())
+            {
+                SetObject(PushFrame(FrameKind::Object, variant(), Commit{}), m_Root);
+                return true;
+            }
+
+            Frame& parent = m_Frames.back();
+            switch (parent.kind)
+            {
+                case FrameKind::Object:
+                {
+                    const PropertyPlan* propertyPlan = parent.pendingProperty;
+                    parent.pendingProperty = nullptr;
+                    if (propertyPlan == nullptr || propertyPlan->kind != PropertyKind::Object)
+                    {
+                        break;
+                    }
+                    // Objects inside a member list object are filled in place
+                    if (parent.address != nullptr)
+                    {
+                        std::optional<instance> member;
+                        parent.memberList->memberObject(parent.address, GetMember(parent, *propertyPlan), member);
+                        if (member)
+                        {
+                            SetObject(PushFrame(FrameKind::Object, variant(), Commit{}), *member);
+                            return true;
+                        }
+                        break;
+                    }
+                    // Properties return a copy, it is filled and set back when the object ends
+                    if (PushObject(propertyPlan->prop.get_value(*parent.object), Commit{ CommitKind::Property, &propertyPlan->prop }))
+                    {
+                        return true;
+                    }
+                    break;
+                }
+                case FrameKind::Sequential:
+                {
+                    size_t index = 0;
+                    if (!NextElement(parent, index))
+                    {
+                        break;
+                    }
+                    // Extract the wrapped value and copied it into a new variant, set back when the object ends
+                    if (PushObject(parent.sequentialView.get_value(index).extract_wrapped_value(), Commit{ CommitKind::Element, nullptr, index }))
+                    {
+                        return true;
+                    }
+                    break;
+                }
+                case FrameKind::Associative:
+                {
+                    Frame& entry = PushFrame(FrameKind::Entry, variant(), Commit{});
+                    entry.keyType = parent.associativeView.get_key_type();
+                    entry.valueType = parent.associativeView.get_value_type();
+                    return true;
+                }
+                case FrameKind::Entry:
+                {
+                    const EntrySlot slot = parent.slot;
+                    parent.slot = EntrySlot::None;
+                    if (slot == EntrySlot::None)
+                    {
+                        break;
+                    }
+                    if (PushObject(Reader::CreateValue(slot == EntrySlot::Key ? parent.keyType : parent.valueType),
+                        Commit{ slot == EntrySlot::Key ? CommitKind::EntryKey : CommitKind::EntryValue }))
+                    {
+                        return true;
+                    }
+                    break;
+                }
+            }
+
+            m_SkipDepth = 1;
+            return true;
+        }
+
+        bool Key(const char* name, SizeType length, bool)
+        {
+            if (m_SkipDepth > 0)
+            {
+                return true;
+            }
+
+            Frame& frame = m_Frames.back();
+            if (frame.kind == FrameKind::Entry)
+            {
+                const string_view key(name, length);
+                frame.slot = key == "key" ? EntrySlot::Key : key == "value" ? EntrySlot::Value : EntrySlot::None;
+            }
+            else
+            {
+                // nullptr when this member is not a property of this type, its value is then skipped
+                frame.pendingProperty = frame.plan->FindProperty(name, length);
+            }
+            return true;
+        }
+
+        // Binary::Decoder sends the index of the property in its TypePlan instead of its name
+        bool PropertyId(uint32_t index)
+        {
+            if (m_SkipDepth > 0)
+            {
+                return true;
+            }
+
+            Frame& frame = m_Frames.back();
+            if (frame.kind == FrameKind::Object)
+            {
+                frame.pendingProperty = index < frame.plan->properties.size() ? &frame.plan->properties[index] : nullptr;
+            }
+            else
+            {
+                frame.slot = EntrySlot::None;
+            }
+            return true;
+        }
+
+        bool EndObject(SizeType)
+        {
+            if (m_SkipDepth > 0)
+            {
+                --m_SkipDepth;
+                return true;
+            }
+            return PopFrame();
+        }
+
+        bool StartArray()
+        {
+            if (m_SkipDepth > 0 || m_Frames.empty())
+            {
+                // The root has to be an object, like Reader::ReadFromJsonRecursively
+                ++m_SkipDepth;
+                return true;
+            }
+
+            Frame& parent = m_Frames.back();
+            switch (parent.kind)
+            {
+                case FrameKind::Object:
+                {
+                    const PropertyPlan* propertyPlan = parent.pendingProperty;
+                    parent.pendingProperty = nullptr;
+                    if (propertyPlan == nullptr)
+                    {
+                        break;
+                    }
+                    // Properties return a copy of the container, it is filled and set back when the array ends
+                    if (PushContainer(propertyPlan->prop.get_value(*parent.object), Commit{ CommitKind::Property, &propertyPlan->prop }))
+                    {
+                        return true;
+                    }
+                    break;
+                }
+                case FrameKind::Sequential:
+                {
+                    size_t index = 0;
+                    if (!NextElement(parent, index))
+                    {
+                        break;
+                    }
+                    // Nested container, wrapped inside std::reference_wrapper<T> so it is filled in place
+                    if (PushContainer(parent.sequentialView.get_value(index), Commit{}))
+                    {
+                        return true;
+                    }
+                    break;
+                }
+                case FrameKind::Associative:
+                    break;
+                case FrameKind::Entry:
+                {
+                    const EntrySlot slot = parent.slot;
+                    parent.slot = EntrySlot::None;
+                    if (slot == EntrySlot::None)
+                    {
+                        break;
+                    }
+                    if (PushContainer(Reader::CreateValue(slot == EntrySlot::Key ? parent.keyType : parent.valueType),
+                        Commit{ slot == EntrySlot::Key ? CommitKind::EntryKey : CommitKind::EntryValue }))
+                    {
+                        return true;
+                    }
+                    break;
+                }
+            }
+
+            m_SkipDepth = 1;
+            return true;
+        }
+
+        bool EndArray(SizeType)
+        {
+            if (m_SkipDepth > 0)
+            {
+                --m_SkipDepth;
+                return true;
+            }
+            return PopFrame();
+        }
+
+    private:
+        enum class FrameKind
+        {
+            Object,         // Reflected class/struct, members are properties
+            Sequential,     // Elements go into sequentialView one after another
+            Associative,    // Key only elements or {"key","value"} entries
+            Entry           // One {"key","value"} entry of an associative container
+        };
+
+        enum class EntrySlot
+        {
+            None,
+            Key,
+            Value
+        };
+
+        // What has to be done with a frame's value once it is closed, on the frame below it
+        enum class CommitKind
+        {
+            None,           // Root, or filled in place
+            Property,       // property.set_value on the parent object
+            Element,        // set_value(index) on the parent sequential container
+            EntryKey,
+            EntryValue
+        };
+
+        struct Commit
+        {
+            CommitKind kind = CommitKind::None;
+            const property* prop = nullptr;
+            size_t index = 0;
+        };
+
+        struct Frame
+        {
+            FrameKind kind;
+            // Value being filled, owned by the frame (empty for the root, which is m_Root)
+            variant value;
+            Commit commit;
+
+            // Object, instance can not be assigned so it is emplaced once the value is in place
+            std::optional<instance> object;
+            const TypePlan* plan = nullptr;
+            // Object with a member list, its scalars are set through memberList instead of RTTR
+            const MemberListSerializer* memberList = nullptr;
+            void* address = nullptr;
+            // Property named by the last key, nullptr if the member is skipped
+            const PropertyPlan* pendingProperty = nullptr;
+
+            // Sequential
+            variant_sequential_view sequentialView;
+            size_t nextIndex = 0;
+            type elementType = type::get<void>();
+            Reader::AtomicElementReadFunction readElement = nullptr;
+            // Numbers go straight into the container memory, nullptr if it is not a contiguous arithmetic container
+            const ContiguousContainer* contiguous = nullptr;
+
+            // Associative
+            variant_associative_view associativeView;
+
+            // Entry
+            EntrySlot slot = EntrySlot::None;
+            type keyType = type::get<void>();
+            type valueType = type::get<void>();
+            variant key;
+            variant entryValue;
+        };
+
+        Frame& PushFrame(FrameKind kind, variant&& value, const Commit& commit)
+        {
+            // std::deque never moves its elements on push/pop at the back, views and instances into value stay valid
+            Frame& frame = m_Frames.emplace_back();
+            frame.kind = kind;
+            frame.value = std::move(value);
+            frame.commit = commit;
+            return frame;
+        }
+
+        // False if value is not valid, nothing is pushed then
+        bool PushObject(variant&& value, const Commit& commit)
+        {
+            if (!value.is_valid())
+            {
+                return false;
+            }
+
+            Frame& frame = PushFrame(FrameKind::Object, std::move(value), commit);
+            const instance object{ frame.value };
+            SetObject(frame, object.get_type().get_raw_type().is_wrapper() ? object.get_wrapped_instance() : object);
+            return true;
+        }
+
+        static void SetObject(Frame& frame, const instance& object)
+        {
+            frame.object.emplace(object);
+            frame.plan = &GetTypePlan(frame.object->get_derived_type());
+            frame.memberList = frame.plan->memberList;
+            frame.address = frame.memberList != nullptr ? frame.memberList->address(*frame.object) : nullptr;
+        }
+
+        // Member list index of a property of frame's object
+        static uint32_t GetMember(const Frame& frame, const PropertyPlan& propertyPlan)
+        {
+            return frame.memberList->propertyMembers[static_cast<size_t>(&propertyPlan - frame.plan->properties.data())];
+        }
+
+        // False if value is not a container, nothing is pushed then
+        bool PushContainer(variant&& value, const Commit& commit)
+        {
+            if (value.is_sequential_container())
+            {
+                Frame& frame = PushFrame(FrameKind::Sequential, std::move(value), commit);
+                frame.sequentialView = frame.value.create_sequential_view();
+                // Elements are appended as they arrive, a fixed size container keeps its size
+                frame.sequentialView.set_size(0);
+                frame.elementType = frame.sequentialView.get_value_type();
+                frame.readElement = Reader::ATOMIC_ELEMENT_READERS[static_cast<size_t>(GetAtomicType(frame.elementType))];
+                const type containerType = frame.value.get_type();
+                frame.contiguous = FindContiguousContainer(containerType.is_wrapper() ? containerType.get_wrapped_type() : containerType);
+                return true;
+            }
+            if (value.is_associative_container())
+            {
+                Frame& frame = PushFrame(FrameKind::Associative, std::move(value), commit);
+                frame.associativeView = frame.value.create_associative_view();
+                return true;
+            }
+            return false;
+        }
+
+        // Makes room for the next element of a sequential frame, false if a fixed size container is already full
+        static bool NextElement(Frame& frame, size_t& index)
+        {
+            index = frame.nextIndex++;
+            if (index < frame.sequentialView.get_size())
+            {
+                return true;
+            }
+            return frame.sequentialView.is_dynamic() && frame.sequentialView.set_size(index + 1);
+        }
+
+        // Appends one number to a contiguous frame, written straight into the container memory
+        static void ReadContiguousElement(Frame& frame, const Value& jsonValue)
+        {
+            const size_t index = frame.nextIndex++;
+            void* data = nullptr;
+            size_t count = 0;
+            // Grows like push_back, a fixed size container keeps its size
+            if (frame.contiguous->resize(frame.value, index + 1, data, count) && index < count)
+            {
+                void* element = static_cast<char*>(data) + index * frame.contiguous->elementSize;
+                Reader::CONTIGUOUS_READERS[static_cast<size_t>(frame.contiguous->elementType)](element, &jsonValue, 1);
+            }
+        }
+
+        bool ReadScalar(const Value& jsonValue)
+        {
+            if (m_SkipDepth > 0 || m_Frames.empty())
+            {
+                return true;
+            }
+
+            Frame& frame = m_Frames.back();
+            switch (frame.kind)
+            {
+                case FrameKind::Object:
+                {
+                    if (frame.pendingProperty != nullptr && frame.address != nullptr)
+                    {
+                        frame.memberList->readMember(frame.address, GetMember(frame, *frame.pendingProperty), jsonValue);
+                        frame.pendingProperty = nullptr;
+                    }
+                    else if (frame.pendingProperty != nullptr)
+                    {
+                        if (!Reader::ReadScalarProperty(*frame.object, *frame.pendingProperty, jsonValue))
+                        {
+                            ReportDiagnostic(ErrorCode::ValueMismatch, frame.pendingProperty->name, frame.pendingProperty->valueType);
+                        }
+                        frame.pendingProperty = nullptr;
+                    }
+                    break;
+                }
+                case FrameKind::Sequential:
+                {
+                    size_t index = 0;
+                    if (frame.contiguous != nullptr)
+                    {
+                        ReadContiguousElement(frame, jsonValue);
+                    }
+                    else if (NextElement(frame, index))
+                    {
+                        if (!Reader::ReadScalarElement(frame.sequentialView, index, frame.readElement, frame.elementType, jsonValue))
+                        {
+                            ReportDiagnostic(ErrorCode::ValueMismatch, std::string_view(), frame.elementType);
+                        }
+                    }
+                    break;
+                }
+                case FrameKind::Associative:
+                {
+                    // Key only value
+                    variant extractedValue = Reader::ReadAtomicTypes(jsonValue);
+                    if (extractedValue && extractedValue.convert(frame.associativeView.get_key_type()))
+                    {
+                        frame.associativeView.insert(extractedValue);
+                    }
+                    break;
+                }
+                case FrameKind::Entry:
+                {
+                    if (frame.slot != EntrySlot::None)
+                    {
+                        variant extractedValue = Reader::ReadAtomicTypes(jsonValue);
+                        const bool isKey = frame.slot == EntrySlot::Key;
+                        const type& entryType = isKey ? frame.keyType : frame.valueType;
+                        if (extractedValue.convert(entryType))
+                        {
+                            (isKey ? frame.key : frame.entryValue) = std::move(extractedValue);
+                        }
+                        frame.slot = EntrySlot::None;
+                    }
+                    break;
+                }
+            }
+            return true;
+        }
+
+        // Closes the top frame and hands its value to the frame below
+        bool PopFrame()
+        {
+            if (m_Frames.empty())
+            {
+                return false;
+            }
+
+            Frame& frame = m_Frames.back();
+            if (frame.kind == FrameKind::Sequential && frame.sequentialView.is_dynamic())
+            {
+                // A container that already had more elements keeps only the ones read
+                frame.sequentialView.set_size(frame.nextIndex);
+            }
+            else if (frame.kind == FrameKind::Entry && frame.key && frame.entryValue)
+            {
+                m_Frames[m_Frames.size() - 2].associativeView.insert(frame.key, frame.entryValue);
+            }
+
+            const Commit commit = frame.commit;
+            variant value = std::move(frame.value);
+            m_Frames.pop_back();
+
+            if (m_Frames.empty())
+            {
+                m_Complete = true;
+                return true;
+            }
+
+            Frame& parent = m_Frames.back();
+            switch (commit.kind)
+            {
+                case CommitKind::None:
+                    break;
+                case CommitKind::Property:
+                    commit.prop->set_value(*parent.object, value);
+                    break;
+                case CommitKind::Element:
+                    parent.sequentialView.set_value(commit.index, value);
+                    break;
+                case CommitKind::EntryKey:
+                    parent.key = std::move(value);
+                    break;
+                case CommitKind::EntryValue:
+                    parent.entryValue = std::move(value);
+                    break;
+            }
+            return true;
+        }
+
+        // Private Variables
+        instance m_Root;
+        std::deque<Frame> m_Frames;
+        // Depth inside a value that is being skipped, 0 when not skipping
+        size_t m_SkipDepth = 0;
+        bool m_Complete = false;
+    };
+
+    // This class is for whoever wish to have their data to be serialized. Some examples are components who will inherit this class
+    // Only Inherit this if you do not want to use RTTR, **which you should be using**
+    class SerializeBase
+    {
+    public:
+        virtual ~SerializeBase() = default;
+        virtual void Deserialize(Reader reader) = 0;
+        virtual void Serialize(Writer writer) = 0;
+
+    private:
+    };
+
+    // This class is for the owner that is responsible for calling SerializeToFile or DeserializeFromFile function
+    class Serialization : public SerializeBase
+    {
+    public:
+        // Delete Copy Constructor & Assignment Operator, Idw this class to be copyable
+        Serialization(const Serialization&) = delete;
+        Serialization& operator=(const Serialization&) = delete;
+
+        // Default Constructor
+        Serialization() = default;
+
+        SerializationResult SerializeToFile(const std::filesystem::path& filePath)
+        {
+            FilePointer file = OpenFile(filePath, "wb");
+            // Check if file is opened
+            if (!file)
+            {
+                return ReportError(ErrorCode::FileNotWritable, filePath.u8string());
+            }
+
+            // Stream straight into the file instead of building the whole string first
+            char writeBuffer[WRITE_BUFFER_SIZE];
+            OutputStream stream{ file.get(), writeBuffer, sizeof(writeBuffer) };
+            Serialize(stream);
+            stream.Flush();
+            return stream.Good() ? SerializationResult{} : ReportError(ErrorCode::FileWriteFailed, filePath.u8string());
+        }
+
+        // Default Serialize Function
+        void Serialize(Writer writer) override
+        {
+            // Testing //
+            //std::string dog{ "dog" };
+            //variant variantType = dog;
+            //writer.WriteVariant(variantType);
+            //// This should be overriden by the class that inherits Serialize //
+            //std::vector<std::string> dogVector;
+            //dogVector.push_back("Cb");
+            //dogVector.push_back("Knn");
+            //writer.PutContainerValue("DogVector", dogVector);
+
+            //std::map<std::string, int> cowMap;
+            //cowMap.emplace("cow", 1);
+            //cowMap.emplace("cownnie", 2);
+            //writer.PutContainerValue("CowMap", cowMap);
+
+            //writer.PutKey("alllah");
+            //writer.PutValue(1);
+        }
+
+        // rttrObj is the object where all your properties and methods are stored
+        virtual std::string Serialize()
+        {
+            std::string json;
+            char writeBuffer[WRITE_BUFFER_SIZE];
+            OutputStream stream{ json, writeBuffer, sizeof(writeBuffer) };
+            Serialize(stream);
+            stream.Flush();
+            return json;
+        }
+
+        // Same as above into the output of context, valid until the next save through context
+        std::string_view Serialize(SerializationContext& context)
+        {
+            context.Begin();
+            Serialize(context.GetPrettyWriter());
+            return context.End();
+        }
+
+        // Writes the object wrapping Serialize(Writer) into stream
+        void Serialize(OutputStream& stream)
+        {
+            PrettyWriter<OutputStream> writer(stream);
+            Serialize(writer);
+        }
+
+        // Writes the object wrapping Serialize(Writer) with writer
+        void Serialize(PrettyWriter<OutputStream>& writer)
+        {
+            const Writer ownWriter{ writer };
+            ownWriter.StartObject();
+            Serialize(ownWriter);
+            ownWriter.EndObject();
+        }
+
+        SerializationResult DeserializeFromFile(const std::filesystem::path& filePath)
+        {
+            InsituBuffer buffer;
+
+            // Check if the file is good first
+            if (!buffer.ReadFile(filePath))
+            {
+                return ReportError(ErrorCode::FileNotFound, filePath.u8string());
+            }
+            return Deserialize(buffer);
+        }
+
+        // Same as above with the file contents and the Document in context
+        SerializationResult DeserializeFromFile(const std::filesystem::path& filePath, DeserializationContext& context)
+        {
+            // Check if the file is good first
+            if (!context.GetBuffer().ReadFile(filePath))
+            {
+                return ReportError(ErrorCode::FileNotFound, filePath.u8string());
+            }
+
+            ContextDocument& document = context.NewDocument();
+            if (context.GetBuffer().Empty())
+            {
+                return ReportError(ErrorCode::EmptyBuffer, filePath.u8string());
+            }
+            if (document.ParseInsitu(context.GetBuffer().GetData()).HasParseError())
+            {
+                return ReportError(ErrorCode::ParseError, GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+            }
+
+            Deserialize(Reader{ document });
+            return SerializationResult{};
+        }
+
+        // Parses buffer in place, strings in the Document point into buffer instead of being copied
+        SerializationResult Deserialize(InsituBuffer& buffer)
+        {
+            Document document;
+
+            if (buffer.Empty())
+            {
+                return ReportError(ErrorCode::EmptyBuffer);
+            }
+            if (document.ParseInsitu(buffer.GetData()).HasParseError())
+            {
+                return ReportError(ErrorCode::ParseError, GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+            }
+
+            Deserialize(Reader{ document });
+            return SerializationResult{};
+        }
+
+        bool InitDocument(const std::string& validJSONName, rapidjson::Document& doc)
+        {
+            if (validJSONName.empty())
+            {
+                return false;
+            }
+
+            //Return false if parsing of document has error
+            return !doc.Parse(validJSONName.c_str()).HasParseError();
+        }
+
+        //Deserialize it
+        SerializationResult Deserialize(const std::string& validJSONName)
+        {
+            //Create a document first
+            Document document;
+
+            //Parse JSON into string validJSONName, return the error if it fails
+            if (!InitDocument(validJSONName, document))
+            {
+                return ReportError(ErrorCode::ParseError);
+            }
+
+            Deserialize(Reader{ document });
+            return SerializationResult{};
+        }
+
+        // Default Deserialize Function
+        void Deserialize(Reader reader) override
+        {
+            //std::vector<std::string> dogVector;
+            //reader.GetContainerValue(dogVector, "DogVector");
+            //for (auto itr : dogVector)
+            //{
+            //    std::cout << itr.c_str() << std::endl;
+            //}
+
+            //std::map<std::string, int> cowMap;
+            //reader.GetContainerValue(cowMap, "CowMap");
+            //for (auto itr : cowMap)
+            //{
+            //    std::cout << itr.first << std::endl;
+            //    std::cout << itr.second << std::endl;
+            //}
+
+            //std::string s = "alllah";
+            //int allahValue = reader.GetValue<int>(s);
+            //std::cout << allahValue << std::endl;
+        }
+    private:
+    };
+
+
+    // *********************************************************
+    // *Exposed Serialize Functions to serialize data to a JSON file
+    // *How To Use*
+    //
+    // *********************************************************
+    // Runs the RTTR walk with the writer that matches format, output goes into stream
+    void WriteToStream(OutputStream& stream, const instance& obj, JsonFormat format)
+    {
+        if (format == JsonFormat::Compact)
+        {
+            rapidjson::Writer<OutputStream> writer(stream);
+            CompactWriter ownWriter{ writer };
+            ownWriter.WriteToJSONRecursively(obj);
+        }
+        else
+        {
+            PrettyWriter<OutputStream> writer(stream);
+            Writer ownWriter{ writer };
+            ownWriter.WriteToJSONRecursively(obj);
+        }
+    }
+
+    std::string ToJsonFormat(const instance& obj, JsonFormat format = JsonFormat::Pretty)
+    {
+        if (!obj.is_valid())
+        {
+            ReportDiagnostic(ErrorCode::InvalidObject);
+            return std::string();
+        }
+
+        // Writes straight into the returned string, no intermediate StringBuffer copy
+        std::string json;
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        OutputStream stream{ json, writeBuffer, sizeof(writeBuffer) };
+        WriteToStream(stream, obj, format);
+        stream.Flush();
+        return json;
+    }
+
+    // Same as above into the output of context, no allocation once context has seen a save this big
+    // The view is only valid until the next save through context
+    std::string_view ToJsonFormat(const instance& obj, SerializationContext& context, JsonFormat format = JsonFormat::Pretty)
+    {
+        context.Begin();
+        if (!obj.is_valid())
+        {
+            ReportDiagnostic(ErrorCode::InvalidObject);
+            return context.End();
+        }
+
+        if (format == JsonFormat::Compact)
+        {
+            CompactWriter ownWriter{ context.GetCompactWriter() };
+            ownWriter.WriteToJSONRecursively(obj);
+        }
+        else
+        {
+            Writer ownWriter{ context.GetPrettyWriter() };
+            ownWriter.WriteToJSONRecursively(obj);
+        }
+        return context.End();
+    }
+
+    // Streams the JSON into the file while the RTTR walk runs, peak memory stays at WRITE_BUFFER_SIZE
+    SerializationResult SerializeToFile(const std::filesystem::path& filePath, const instance& obj, JsonFormat format = JsonFormat::Pretty)
+    {
+        if (!obj.is_valid())
+        {
+            return ReportError(ErrorCode::InvalidObject);
+        }
+
+        FilePointer file = OpenFile(filePath, "wb");
+        // Check if file is opened
+        if (!file)
+        {
+            return ReportError(ErrorCode::FileNotWritable, filePath.u8string());
+        }
+
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        OutputStream stream{ file.get(), writeBuffer, sizeof(writeBuffer) };
+        WriteToStream(stream, obj, format);
+        stream.Flush();
+        return stream.Good() ? SerializationResult{} : ReportError(ErrorCode::FileWriteFailed, filePath.u8string());
+    }
+
+    // *********************************************************
+    // *Batch Serialize Functions, many instances into one JSON array in input order, written on threadCount worker threads
+    // *The instances are cut into blocks, every worker takes the next block from an atomic counter and writes it with its own writer
+    // *Every block is written as an array of its own, the brackets are cut off and the blocks are joined in block order,
+    // *so the output does not depend on which worker wrote what
+    // *Objects is any random access range whose elements an rttr::instance can be made from (std::vector<instance>, std::vector<circle>...)
+    // *The types in it should have been saved once before (or have their plans built) so the workers do not all build them at the same time
+    // *********************************************************
+    // Elements per block, enough blocks per worker that a slow block does not leave the other workers waiting
+    constexpr size_t BATCH_BLOCKS_PER_THREAD = 8;
+
+    // objects[begin, end) as a JSON array into block
+    template <typename Range>
+    void WriteBatchBlock(const Range& objects, size_t begin, size_t end, JsonFormat format, std::string& block)
+    {
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        OutputStream stream{ block, writeBuffer, sizeof(writeBuffer) };
+
+        if (format == JsonFormat::Compact)
+        {
+            rapidjson::Writer<OutputStream> writer(stream);
+            CompactWriter ownWriter{ writer };
+            ownWriter.StartArray();
+            for (size_t i = begin; i < end; ++i)
+            {
+                ownWriter.WriteToJSONRecursively(instance(objects[i]));
+            }
+            ownWriter.EndArray();
+        }
+        else
+        {
+            PrettyWriter<OutputStream> writer(stream);
+            Writer ownWriter{ writer };
+            ownWriter.StartArray();
+            for (size_t i = begin; i < end; ++i)
+            {
+                // The array separator before every element uses the current format, it has to be the same in every block
+                ownWriter.SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+                ownWriter.WriteToJSONRecursively(instance(objects[i]));
+            }
+            // An element that ends in a sequential container leaves kFormatSingleLineArray set, EndArray would then
+            // skip the "\n" WriteBatchBlocks cuts off with the bracket
+            ownWriter.SetFormatOptions(PrettyFormatOptions::kFormatDefault);
+            ownWriter.EndArray();
+        }
+        stream.Flush();
+    }
+
+    // Every block of objects written by WriteBatchBlock, in order
+    template <typename Range>
+    std::vector<std::string> WriteBatchBlocks(const Range& objects, JsonFormat format, unsigned threadCount)
+    {
+        const size_t objectCount = static_cast<size_t>(std::size(objects));
+        if (threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        const size_t blockSize = std::max<size_t>(1, objectCount / (static_cast<size_t>(threadCount) * BATCH_BLOCKS_PER_THREAD));
+        const size_t blockCount = (objectCount + blockSize - 1) / blockSize;
+        std::vector<std::string> blocks(blockCount);
+        std::atomic<size_t> nextBlock{ 0 };
+
+        const auto work = [&]()
+        {
+            for (size_t block = nextBlock.fetch_add(1); block < blockCount; block = nextBlock.fetch_add(1))
+            {
+                const size_t begin = block * blockSize;
+                WriteBatchBlock(objects, begin, std::min(begin + blockSize, objectCount), format, blocks[block]);
+            }
+        };
+
+        // The calling thread is one of the workers
+        std::vector<std::thread> workers;
+        const size_t workerCount = std::min<size_t>(threadCount, blockCount);
+        for (size_t i = 1; i < workerCount; ++i)
+        {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        return blocks;
+    }
+
+    // Joins the blocks into one array in stream
+    void WriteBatchBlocks(OutputStream& stream, const std::vector<std::string>& blocks, JsonFormat format)
+    {
+        // Compact blocks are "[...]" and Pretty blocks "[\n...\n]", an empty block is "[]" in both
+        const bool isPretty = format == JsonFormat::Pretty;
+        const size_t bracketSize = isPretty ? 2 : 1;
+        bool isFirst = true;
+
+        stream.Put('[');
+        for (const std::string& block : blocks)
+        {
+            if (block.size() <= 2)
+            {
+                continue;
+            }
+
+            if (isPretty)
+            {
+                stream.Write(isFirst ? "\n" : ",\n", isFirst ? 1 : 2);
+            }
+            else if (!isFirst)
+            {
+                stream.Put(',');
+            }
+            stream.Write(block.data() + bracketSize, block.size() - 2 * bracketSize);
+            isFirst = false;
+        }
+
+        if (isPretty && !isFirst)
+        {
+            stream.Put('\n');
+        }
+        stream.Put(']');
+    }
+
+    // threadCount 0 uses every hardware thread
+    template <typename Range>
+    std::string ToJsonFormatBatch(const Range& objects, JsonFormat format = JsonFormat::Pretty, unsigned threadCount = 0)
+    {
+        const std::vector<std::string> blocks = WriteBatchBlocks(objects, format, threadCount);
+
+        size_t size = 2;
+        for (const std::string& block : blocks)
+        {
+            size += block.size();
+        }
+
+        std::string json;
+        json.reserve(size);
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        OutputStream stream{ json, writeBuffer, sizeof(writeBuffer) };
+        WriteBatchBlocks(stream, blocks, format);
+        stream.Flush();
+        return json;
+    }
+
+    template <typename Range>
+    SerializationResult SerializeToFileBatch(const std::filesystem::path& filePath, const Range& objects, JsonFormat format = JsonFormat::Pretty, unsigned threadCount = 0)
+    {
+        FilePointer file = OpenFile(filePath, "wb");
+        // Check if file is opened
+        if (!file)
+        {
+            return ReportError(ErrorCode::FileNotWritable, filePath.u8string());
+        }
+
+        const std::vector<std::string> blocks = WriteBatchBlocks(objects, format, threadCount);
+
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        OutputStream stream{ file.get(), writeBuffer, sizeof(writeBuffer) };
+        WriteBatchBlocks(stream, blocks, format);
+        stream.Flush();
+        return stream.Good() ? SerializationResult{} : ReportError(ErrorCode::FileWriteFailed, filePath.u8string());
+    }
+
+    // *********************************************************
+    // *Exposed Deserialize Functions to deserialize data from a JSON file into an instance of rttr
+    // *How To Use*
+    //
+    // *********************************************************
+    // Parses json in place into document and reads it into rttrObject
+    // document is a Document or the ContextDocument of a DeserializationContext
+    template <typename DocumentType>
+    SerializationResult ReadDocument(DocumentType& document, char* json, instance rttrObject)
+    {
+        // Create own reader
+        Reader ownReader{ document };
+
+        if (json == nullptr || *json == '\0')
+        {
+            return ReportError(ErrorCode::EmptyBuffer);
+        }
+        JSON_TRACE_LOAD(rttrObject.get_derived_type(), std::strlen(json));
+
+        //Return the error if parsing of document has error
+        if (document.ParseInsitu(json).HasParseError())
+        {
+            return ReportError(ErrorCode::ParseError, GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+        }
+
+        ownReader.ReadFromJsonRecursively(rttrObject, ownReader.GetValueData());
+        return SerializationResult{};
+    }
+
+    // json has to be null terminated and mutable, ParseInsitu decodes the strings inside json itself
+    // The strings in the Document point into json so nothing is copied until the values are set on rttrObject
+    SerializationResult FromJsonFormat(char* json, instance rttrObject)
+    {
+        // GenericDocument with UTF8 encoding
+        Document document;
+        return ReadDocument(document, json, rttrObject);
+    }
+
+    // Same as above with the Document in the arenas of context, use this when loading many files one after another
+    SerializationResult FromJsonFormat(char* json, instance rttrObject, DeserializationContext& context)
+    {
+        return ReadDocument(context.NewDocument(), json, rttrObject);
+    }
 
-            for (property propertie : propertyList)
-            {
-                // Check if the property i'm looking for exist inside jsonValue
-                Value::MemberIterator propertyExist = jsonObject.FindMember(propertie.get_name().data());
-                if (propertyExist == jsonObject.MemberEnd())
-                {
-                    continue;
-                }
+    // Same as FromJsonFormat but without a Document, the values are set on rttrObject while json is parsed
+    // json has to be null terminated and mutable, the strings are decoded inside json itself
+    SerializationResult FromJsonFormatSax(char* json, instance rttrObject)
+    {
+        if (json == nullptr || *json == '\0')
+        {
+            return ReportError(ErrorCode::EmptyBuffer);
+        }
+        JSON_TRACE_LOAD(rttrObject.get_derived_type(), std::strlen(json));
 
-                const type valueType = propertie.get_type();
-                auto& jsonValue = propertyExist->value;
-                switch (jsonValue.GetType())
-                {
-                    case kArrayType:
-                    {
-                        variant value;
-                        if (valueType.is_sequential_container())
-                        {
-                            value = propertie.get_value(object);
-                            variant_sequential_view sequentialView = value.create_sequential_view();
-                            ReadArray(sequentialView, jsonValue);
-                        }
-                        else if (valueType.is_associative_container())
-                        {
-                            value = propertie.get_value(object);
-                            variant_associative_view associative_view = value.create_associative_view();
-                            ReadAssociativeContainer(associative_view, jsonValue);
-                        }
-                        propertie.set_value(object, value);
-                        break;
-                    }
-                    case kObjectType:
-                    {
-                        variant value = propertie.get_value(object);
-                        ReadFromJsonRecursively(value, jsonValue);
-                        propertie.set_value(object, value);
-                        break;
-                    }
-                    default:
-                    {
-                        variant extractedValue = ReadAtomicTypes(jsonValue);
-                        if (extractedValue.convert(valueType))
-                        {
-                            // REMARK: CONVERSION WORKS ONLY WITH "const type", check whether this is correct or not!
-                            propertie.set_value(object, extractedValue);
-                        }
-                    }
-                }
-            }
+        SaxReader handler{ rttrObject };
+        rapidjson::Reader reader;
+        InsituStringStream stream{ json };
+        if (reader.Parse<kParseInsituFlag>(stream, handler).IsError() || !handler.IsComplete())
+        {
+            return ReportError(ErrorCode::ParseError, GetParseError_En(reader.GetParseErrorCode()), reader.GetErrorOffset());
         }
+        return SerializationResult{};
+    }
 
-        Value& GetValueData() const
+    // Same as above with the parse stack in the arena of context
+    SerializationResult FromJsonFormatSax(char* json, instance rttrObject, DeserializationContext& context)
+    {
+        if (json == nullptr || *json == '\0')
         {
-            return *m_Data;
+            return ReportError(ErrorCode::EmptyBuffer);
         }
+        JSON_TRACE_LOAD(rttrObject.get_derived_type(), std::strlen(json));
 
-    private:
-        Value* m_Data = nullptr;
-    };
+        context.Reset();
+        SaxReader handler{ rttrObject };
+        GenericReader<UTF8<>, UTF8<>, MemoryPoolAllocator<>> reader{ &context.GetStackAllocator() };
+        InsituStringStream stream{ json };
+        if (reader.Parse<kParseInsituFlag>(stream, handler).IsError() || !handler.IsComplete())
+        {
+            return ReportError(ErrorCode::ParseError, GetParseError_En(reader.GetParseErrorCode()), reader.GetErrorOffset());
+        }
+        return SerializationResult{};
+    }
 
-    // This class is for whoever wish to have their data to be serialized. Some examples are components who will inherit this class
-    // Only Inherit this if you do not want to use RTTR, **which you should be using**
-    class SerializeBase
+    SerializationResult FromJsonFormat(std::stringstream& buffer, instance rttrObject)
     {
-    public:
-        virtual ~SerializeBase() = default;
-        virtual void Deserialize(Reader reader) = 0;
-        virtual void Serialize(Writer writer) = 0;
-
-    private:
-    };
+        // str() returns a copy every call, take it once and parse that copy in place
+        std::string json = buffer.str();
+        return FromJsonFormat(json.data(), rttrObject);
+    }
 
-    // This class is for the owner that is responsible for calling SerializeToFile or DeserializeFromFile function
-    class Serialization : public SerializeBase
+    // Copies buffer straight from its streambuf into the buffer of context instead of through str()
+    SerializationResult FromJsonFormat(std::stringstream& buffer, instance rttrObject, DeserializationContext& context)
     {
-    public:
-        // Delete Copy Constructor & Assignment Operator, Idw this class to be copyable
-        Serialization(const Serialization&) = delete;
-        Serialization& operator=(const Serialization&) = delete;
+        std::streambuf& source = *buffer.rdbuf();
+        const std::streamoff size = source.pubseekoff(0, std::ios::end, std::ios::in);
+        source.pubseekpos(0, std::ios::in);
+        if (size <= 0)
+        {
+            return ReportError(ErrorCode::EmptyBuffer);
+        }
 
-        // Default Constructor
-        Serialization() = default;
+        InsituBuffer& json = context.GetBuffer();
+        json.Resize(static_cast<size_t>(source.sgetn(json.Resize(static_cast<size_t>(size)), size)));
+        return FromJsonFormat(json.GetData(), rttrObject, context);
+    }
 
-        void SerializeToFile(const std::filesystem::path& filePath)
+    // Reads the file once into an owned buffer and parses it in place
+    SerializationResult DeserializeFromFile(const std::filesystem::path& filePath, instance rttrObject)
+    {
+        InsituBuffer buffer;
+        // Check if filePath is locateable
+        if (buffer.ReadFile(filePath))
         {
-            std::ofstream file{ filePath };
-            // Check if file is in good bit
-            if (file.good())
-            {
-                // Retrieve the strings from SerializeFunction
-                const std::string stringBuffer = Serialize();
-                file << stringBuffer;
-            }
-            else
-            {
-                // Do some Assert to show SerializeToFile failed
-            }
+            return FromJsonFormat(buffer.GetData(), rttrObject);
         }
+        return ReportError(ErrorCode::FileNotFound, filePath.u8string());
+    }
 
-        // Default Serialize Function
-        void Serialize(Writer writer) override
+    // Same as above with the file contents and the Document in context, nothing is allocated once context has seen the biggest file
+    SerializationResult DeserializeFromFile(const std::filesystem::path& filePath, instance rttrObject, DeserializationContext& context)
+    {
+        InsituBuffer& buffer = context.GetBuffer();
+        // Check if filePath is locateable
+        if (buffer.ReadFile(filePath))
         {
-            // Testing //
-            //std::string dog{ "dog" };
-            //variant variantType = dog;
-            //writer.WriteVariant(variantType);
-            //// This should be overriden by the class that inherits Serialize //
-            //std::vector<std::string> dogVector;
-            //dogVector.push_back("Cb");
-            //dogVector.push_back("Knn");
-            //writer.PutContainerValue("DogVector", dogVector);
+            return FromJsonFormat(buffer.GetData(), rttrObject, context);
+        }
+        return ReportError(ErrorCode::FileNotFound, filePath.u8string());
+    }
 
-            //std::map<std::string, int> cowMap;
-            //cowMap.emplace("cow", 1);
-            //cowMap.emplace("cownnie", 2);
-            //writer.PutContainerValue("CowMap", cowMap);
+    // Streams the file through a READ_BUFFER_SIZE buffer into a SaxReader, the file is never held in memory as a whole
+    // Peak memory is the buffer plus one frame per nesting level, use this for level files that are too big for DeserializeFromFile
+    SerializationResult DeserializeFromFileSax(const std::filesystem::path& filePath, instance rttrObject)
+    {
+        FilePointer file = OpenFile(filePath, "rb");
+        if (!file)
+        {
+            return ReportError(ErrorCode::FileNotFound, filePath.u8string());
+        }
 
-            //writer.PutKey("alllah");
-            //writer.PutValue(1);
+        char readBuffer[READ_BUFFER_SIZE];
+        FileReadStream stream{ file.get(), readBuffer, sizeof(readBuffer) };
+        SaxReader handler{ rttrObject };
+        rapidjson::Reader reader;
+        if (reader.Parse(stream, handler).IsError() || !handler.IsComplete())
+        {
+            return ReportError(ErrorCode::ParseError, filePath.u8string(), reader.GetErrorOffset());
         }
+        return SerializationResult{};
+    }
 
-        // rttrObj is the object where all your properties and methods are stored
-        virtual std::string Serialize()
+    // Same as above with the parse stack in the arena of context
+    SerializationResult DeserializeFromFileSax(const std::filesystem::path& filePath, instance rttrObject, DeserializationContext& context)
+    {
+        FilePointer file = OpenFile(filePath, "rb");
+        if (!file)
         {
-            StringBuffer buffer;
-            PrettyWriter<StringBuffer> writer(buffer);
-            const Writer ownWriter{ writer };
-            ownWriter.StartObject();
-            Serialize(writer);
-            ownWriter.EndObject();
-            return buffer.GetString();
+            return ReportError(ErrorCode::FileNotFound, filePath.u8string());
         }
 
-        void DeserializeFromFile(const std::filesystem::path& filePath)
+        context.Reset();
+        char readBuffer[READ_BUFFER_SIZE];
+        FileReadStream stream{ file.get(), readBuffer, sizeof(readBuffer) };
+        SaxReader handler{ rttrObject };
+        GenericReader<UTF8<>, UTF8<>, MemoryPoolAllocator<>> reader{ &context.GetStackAllocator() };
+        if (reader.Parse(stream, handler).IsError() || !handler.IsComplete())
         {
-            std::ifstream file{ filePath };
+            return ReportError(ErrorCode::ParseError, filePath.u8string(), reader.GetErrorOffset());
+        }
+        return SerializationResult{};
+    }
 
-            // Check if the file is good first
-            if (file.good())
-            {
-                std::stringstream buffer;
-                buffer << file.rdbuf();
-                Deserialize(buffer.str());
-            }
+    // *********************************************************
+    // *Batch Deserialize Functions, a top level JSON array into pre constructed objects, element i into objects[i]
+    // *The document is parsed once, then the elements are read on threadCount worker threads, each with its own Reader
+    // *Elements are handed out in blocks through an atomic counter, like the batch serialize functions
+    // *********************************************************
+    struct BatchThreadTiming
+    {
+        size_t objects = 0;
+        double milliseconds = 0.0;
+    };
+
+    // Where the time of a batch load went, threads[0] is the calling thread
+    struct BatchReadReport
+    {
+        double parseMilliseconds = 0.0;
+        double readMilliseconds = 0.0;
+        std::vector<BatchThreadTiming> threads;
+    };
+
+    // Reads the elements of jsonArray into objects, objects has to have one element per JSON element (extra ones on either side are left alone)
+    template <typename Range>
+    void ReadBatchElements(Value& jsonArray, Range& objects, unsigned threadCount, BatchReadReport* report)
+    {
+        const size_t objectCount = std::min(static_cast<size_t>(std::size(objects)), static_cast<size_t>(jsonArray.Size()));
+        if (threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
         }
 
-        bool InitDocument(const std::string& validJSONName, rapidjson::Document& doc)
+        const size_t blockSize = std::max<size_t>(1, objectCount / (static_cast<size_t>(threadCount) * BATCH_BLOCKS_PER_THREAD));
+        const size_t blockCount = (objectCount + blockSize - 1) / blockSize;
+        const size_t workerCount = std::max<size_t>(1, std::min<size_t>(threadCount, blockCount));
+        std::vector<BatchThreadTiming> timings(workerCount);
+        std::atomic<size_t> nextBlock{ 0 };
+
+        const auto work = [&](size_t worker)
         {
-            if (validJSONName.empty())
+            const auto start = std::chrono::steady_clock::now();
+            // Own reader per worker, nothing used for the conversions is shared between the threads
+            Reader ownReader{ jsonArray };
+            for (size_t block = nextBlock.fetch_add(1); block < blockCount; block = nextBlock.fetch_add(1))
             {
-                return false;
+                const size_t begin = block * blockSize;
+                const size_t end = std::min(begin + blockSize, objectCount);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    ownReader.ReadFromJsonRecursively(objects[i], jsonArray[static_cast<SizeType>(i)]);
+                }
+                timings[worker].objects += end - begin;
             }
+            timings[worker].milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
 
-            //Return false if parsing of document has error
-            return !doc.Parse(validJSONName.c_str()).HasParseError();
+        const auto start = std::chrono::steady_clock::now();
+        // The calling thread is one of the workers
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < workerCount; ++i)
+        {
+            workers.emplace_back(work, i);
+        }
+        work(0);
+        for (std::thread& worker : workers)
+        {
+            worker.join();
         }
 
-        //Deserialize it
-        void Deserialize(const std::string& validJSONName)
+        if (report)
         {
-            //Create a document first
-            Document document;
+            report->readMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            report->threads = std::move(timings);
+        }
+    }
 
-            //Parse JSON into string validJSONName, return false if fail
-            if (!InitDocument(validJSONName, document))
-            {
-                std::cout << "Parsing of JSON into string failed" << std::endl;
-                // Do some assert
-            }
+    // Parses json in place into document and reads the elements of its root array into objects
+    template <typename DocumentType, typename Range>
+    SerializationResult ReadBatchDocument(DocumentType& document, char* json, Range& objects, unsigned threadCount, BatchReadReport* report)
+    {
+        if (json == nullptr || *json == '\0')
+        {
+            return ReportError(ErrorCode::EmptyBuffer);
+        }
+        JSON_TRACE_LOAD(type::get<Range>(), std::strlen(json));
 
-            Deserialize(Reader{ document });
+        const auto start = std::chrono::steady_clock::now();
+        if (document.ParseInsitu(json).HasParseError())
+        {
+            return ReportError(ErrorCode::ParseError, GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+        }
+        if (!document.IsArray())
+        {
+            return ReportError(ErrorCode::UnexpectedLayout, "Root of a batch has to be an array");
+        }
+        if (report)
+        {
+            report->parseMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
         }
 
-        // Default Deserialize Function
-        void Deserialize(Reader reader) override
+        // Still reads what fits
+        if (static_cast<size_t>(document.Size()) != static_cast<size_t>(std::size(objects)))
         {
-            //std::vector<std::string> dogVector;
-            //reader.GetContainerValue(dogVector, "DogVector");
-            //for (auto itr : dogVector)
-            //{
-            //    std::cout << itr.c_str() << std::endl;
-            //}
+            ReportDiagnostic(ErrorCode::UnexpectedLayout, "JSON array and objects differ in size");
+        }
 
-            //std::map<std::string, int> cowMap;
-            //reader.GetContainerValue(cowMap, "CowMap");
-            //for (auto itr : cowMap)
-            //{
-            //    std::cout << itr.first << std::endl;
-            //    std::cout << itr.second << std::endl;
-            //}
+        ReadBatchElements(document, objects, threadCount, report);
+        return SerializationResult{};
+    }
 
-            //std::string s = "alllah";
-            //int allahValue = reader.GetValue<int>(s);
-            //std::cout << allahValue << std::endl;
+    // json has to be null terminated and mutable like FromJsonFormat, the root has to be an array
+    // threadCount 0 uses every hardware thread, report is optional
+    template <typename Range>
+    SerializationResult FromJsonFormatBatch(char* json, Range& objects, unsigned threadCount = 0, BatchReadReport* report = nullptr)
+    {
+        Document document;
+        return ReadBatchDocument(document, json, objects, threadCount, report);
+    }
+
+    // Same as above with the Document in the arenas of context, the workers only read from it
+    template <typename Range>
+    SerializationResult FromJsonFormatBatch(char* json, Range& objects, DeserializationContext& context, unsigned threadCount = 0, BatchReadReport* report = nullptr)
+    {
+        return ReadBatchDocument(context.NewDocument(), json, objects, threadCount, report);
+    }
+
+    template <typename Range>
+    SerializationResult DeserializeFromFileBatch(const std::filesystem::path& filePath, Range& objects, unsigned threadCount = 0, BatchReadReport* report = nullptr)
+    {
+        InsituBuffer buffer;
+        if (!buffer.ReadFile(filePath))
+        {
+            return ReportError(ErrorCode::FileNotFound, filePath.u8string());
         }
-    private:
-    };
+        return FromJsonFormatBatch(buffer.GetData(), objects, threadCount, report);
+    }
 
+    template <typename Range>
+    SerializationResult DeserializeFromFileBatch(const std::filesystem::path& filePath, Range& objects, DeserializationContext& context, unsigned threadCount = 0, BatchReadReport* report = nullptr)
+    {
+        InsituBuffer& buffer = context.GetBuffer();
+        if (!buffer.ReadFile(filePath))
+        {
+            return ReportError(ErrorCode::FileNotFound, filePath.u8string());
+        }
+        return FromJsonFormatBatch(buffer.GetData(), objects, context, threadCount, report);
+    }
 
     // *********************************************************
-    // *Exposed Serialize Functions to serialize data to a JSON file
-    // *How To Use*
-    //
+    // *Delta Serialize Functions, only the properties that differ from a baseline are saved
+    // *The baseline is an explicit prefab object, or a default constructed object made through the registered constructor
+    // *Loading a delta applies it on top of an object that already holds the baseline, so the baseline has to be the same one it was saved against
     // *********************************************************
-    std::string ToJsonFormat(const instance& obj)
+    // Default constructed object of the type of obj, invalid if the type has no registered default constructor
+    inline variant CreateBaseline(const instance& obj)
+    {
+        const instance object = obj.get_type().get_raw_type().is_wrapper() ? obj.get_wrapped_instance() : obj;
+        return object.get_derived_type().create();
+    }
+
+    // Sets every serialized property of target to the one of baseline, both have to be of the same type
+    inline void CopyProperties(instance target, const instance& baseline)
+    {
+        const TypePlan& plan = GetTypePlan(target.get_derived_type());
+        for (const PropertyPlan& propertyPlan : plan.properties)
+        {
+            if (!propertyPlan.noSerialize)
+            {
+                propertyPlan.prop.set_value(target, propertyPlan.prop.get_value(baseline));
+            }
+        }
+    }
+
+    void WriteDeltaToStream(OutputStream& stream, const instance& obj, const instance& baseline, JsonFormat format)
+    {
+        if (format == JsonFormat::Compact)
+        {
+            rapidjson::Writer<OutputStream> writer(stream);
+            CompactWriter ownWriter{ writer };
+            ownWriter.WriteDeltaRecursively(obj, baseline);
+        }
+        else
+        {
+            PrettyWriter<OutputStream> writer(stream);
+            Writer ownWriter{ writer };
+            ownWriter.WriteDeltaRecursively(obj, baseline);
+        }
+    }
+
+    std::string ToJsonDelta(const instance& obj, const instance& baseline, JsonFormat format = JsonFormat::Pretty)
     {
         if (!obj.is_valid())
         {
-            std::cout << "RTTR object is not valid!" << std::endl;
+            ReportDiagnostic(ErrorCode::InvalidObject);
             return std::string();
         }
 
-        StringBuffer sb;
-        PrettyWriter<StringBuffer> writer(sb);
-        Writer ownWriter{ writer };
-        ownWriter.WriteToJSONRecursively(obj);
-        return sb.GetString();
+        std::string json;
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        OutputStream stream{ json, writeBuffer, sizeof(writeBuffer) };
+        WriteDeltaToStream(stream, obj, baseline, format);
+        stream.Flush();
+        return json;
+    }
+
+    // Against a default constructed object of the same type
+    std::string ToJsonDelta(const instance& obj, JsonFormat format = JsonFormat::Pretty)
+    {
+        const variant baseline = CreateBaseline(obj);
+        return ToJsonDelta(obj, baseline, format);
     }
 
-    void SerializeToFile(const std::filesystem::path& filePath, const instance& obj)
+    SerializationResult SerializeDeltaToFile(const std::filesystem::path& filePath, const instance& obj, const instance& baseline, JsonFormat format = JsonFormat::Pretty)
     {
-        std::string JSONStringBuffer = ToJsonFormat(obj);
-        std::ofstream file{ filePath };
-        // Check if file is in good bit
-        if (file.good())
+        if (!obj.is_valid())
         {
-            // Retrieve the strings from JSONStringBuffer
-            file << JSONStringBuffer;
+            return ReportError(ErrorCode::InvalidObject);
         }
-        else
+
+        FilePointer file = OpenFile(filePath, "wb");
+        if (!file)
         {
-            // Do some Assert to show SerializeToFile failed
+            return ReportError(ErrorCode::FileNotWritable, filePath.u8string());
         }
+
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        OutputStream stream{ file.get(), writeBuffer, sizeof(writeBuffer) };
+        WriteDeltaToStream(stream, obj, baseline, format);
+        stream.Flush();
+        return stream.Good() ? SerializationResult{} : ReportError(ErrorCode::FileWriteFailed, filePath.u8string());
     }
 
-    // *********************************************************
-    // *Exposed Deserialize Functions to deserialize data from a JSON file into an instance of rttr
-    // *How To Use*
-    //
-    // *********************************************************
-    bool FromJsonFormat(std::stringstream& buffer, instance rttrObject)
+    SerializationResult SerializeDeltaToFile(const std::filesystem::path& filePath, const instance& obj, JsonFormat format = JsonFormat::Pretty)
     {
-        // GenericDocument with UTF8 encoding
+        const variant baseline = CreateBaseline(obj);
+        return SerializeDeltaToFile(filePath, obj, baseline, format);
+    }
+
+    // Applies the delta in json on top of rttrObject, rttrObject has to hold the baseline already (a copy of the prefab, or default constructed)
+    // json has to be null terminated and mutable like FromJsonFormat
+    SerializationResult FromJsonDelta(char* json, instance rttrObject)
+    {
+        if (json == nullptr || *json == '\0')
+        {
+            return ReportError(ErrorCode::EmptyBuffer);
+        }
+
         Document document;
+        if (document.ParseInsitu(json).HasParseError())
+        {
+            return ReportError(ErrorCode::ParseError, GetParseError_En(document.GetParseError()), document.GetErrorOffset());
+        }
 
-        // Create own reader
         Reader ownReader{ document };
+        ownReader.SetReplaceAssociative(true);
+        ownReader.ReadFromJsonRecursively(rttrObject, ownReader.GetValueData());
+        return SerializationResult{};
+    }
+
+    // Resets rttrObject to baseline first, then applies the delta
+    SerializationResult FromJsonDelta(char* json, instance rttrObject, const instance& baseline)
+    {
+        CopyProperties(rttrObject, baseline);
+        return FromJsonDelta(json, rttrObject);
+    }
 
-        if (buffer.str().empty())
+    SerializationResult DeserializeDeltaFromFile(const std::filesystem::path& filePath, instance rttrObject)
+    {
+        InsituBuffer buffer;
+        if (!buffer.ReadFile(filePath))
         {
-            std::cerr << "Buffer from JSON is empty" << std::endl;
-            return false;
+            return ReportError(ErrorCode::FileNotFound, filePath.u8string());
         }
+        return FromJsonDelta(buffer.GetData(), rttrObject);
+    }
 
-        //Return false if parsing of document has error
-        if (document.Parse(buffer.str().c_str()).HasParseError())
+    SerializationResult DeserializeDeltaFromFile(const std::filesystem::path& filePath, instance rttrObject, const instance& baseline)
+    {
+        CopyProperties(rttrObject, baseline);
+        return DeserializeDeltaFromFile(filePath, rttrObject);
+    }
+
+    // *********************************************************
+    // *Trace Export Functions, what the JSON_TRACE_* scopes recorded (Tracing.hpp), empty unless JSONTRACE is defined
+    // *Events are complete events ("ph":"X") with the bytes in args, one tid per traced thread
+    // *typeStats and propertyStats are the merged counts, chrome://tracing and Perfetto ignore them
+    // *********************************************************
+    // Not an OutputStream, its bytes would be counted as written by the thread exporting the trace
+    using TraceWriter = rapidjson::Writer<FileWriteStream>;
+
+    void WriteTraceStats(TraceWriter& writer, const char* key, const std::vector<TraceEntry>& entries)
+    {
+        writer.Key(key);
+        writer.StartArray();
+        for (const TraceEntry& entry : entries)
         {
-            std::cerr << "Parsing of JSON into string failed" << std::endl;
-            return false;
+            writer.StartObject();
+            writer.Key("operation");
+            writer.String(GetTraceOperationName(entry.operation));
+            writer.Key("name");
+            writer.String(entry.name.data(), static_cast<SizeType>(entry.name.size()));
+            writer.Key("count");
+            writer.Uint64(entry.stats.count);
+            writer.Key("nanoseconds");
+            writer.Uint64(entry.stats.nanoseconds);
+            writer.Key("bytes");
+            writer.Uint64(entry.stats.bytes);
+            writer.EndObject();
         }
+        writer.EndArray();
+    }
 
-        ownReader.ReadFromJsonRecursively(rttrObject, ownReader.GetValueData());
-        std::cout << "Reading of JSONValue into rttrObject successful!" << std::endl;
-        return true;
+    void WriteTraceEvents(TraceWriter& writer)
+    {
+        TraceRegistry& registry = GetTraceRegistry();
+        std::lock_guard<std::mutex> lock{ registry.mutex };
+        // Property names are put together once and not once per event
+        std::unordered_map<const PropertyPlan*, std::string> propertyNames;
+
+        writer.Key("traceEvents");
+        writer.StartArray();
+        for (const std::shared_ptr<TraceThread>& thread : registry.threads)
+        {
+            const std::string threadName = "Serializer thread " + std::to_string(thread->threadIndex);
+            writer.StartObject();
+            writer.Key("name");
+            writer.String("thread_name");
+            writer.Key("ph");
+            writer.String("M");
+            writer.Key("pid");
+            writer.Uint(1);
+            writer.Key("tid");
+            writer.Uint(thread->threadIndex);
+            writer.Key("args");
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(threadName.data(), static_cast<SizeType>(threadName.size()));
+            writer.EndObject();
+            writer.EndObject();
+
+            for (const TraceThread::Event& event : thread->events)
+            {
+                writer.StartObject();
+                writer.Key("name");
+                if (event.property != nullptr)
+                {
+                    auto found = propertyNames.find(event.property);
+                    if (found == propertyNames.end())
+                    {
+                        found = propertyNames.emplace(event.property, GetTraceName(event.valueType, event.property)).first;
+                    }
+                    writer.String(found->second.data(), static_cast<SizeType>(found->second.size()));
+                }
+                else
+                {
+                    const string_view typeName = event.valueType.get_name();
+                    writer.String(typeName.data(), static_cast<SizeType>(typeName.size()));
+                }
+                writer.Key("cat");
+                writer.String(GetTraceOperationName(event.operation));
+                writer.Key("ph");
+                writer.String("X");
+                // Chrome traces are in microseconds
+                writer.Key("ts");
+                writer.Double(static_cast<double>(event.start) / 1000.0);
+                writer.Key("dur");
+                writer.Double(static_cast<double>(event.duration) / 1000.0);
+                writer.Key("pid");
+                writer.Uint(1);
+                writer.Key("tid");
+                writer.Uint(thread->threadIndex);
+                writer.Key("args");
+                writer.StartObject();
+                writer.Key("bytes");
+                writer.Uint64(event.bytes);
+                writer.EndObject();
+                writer.EndObject();
+            }
+        }
+        writer.EndArray();
     }
 
-    void DeserializeFromFile(const std::filesystem::path& filePath, instance rttrObject)
+    SerializationResult WriteChromeTrace(const std::filesystem::path& filePath)
     {
-        std::ifstream file{ filePath };
-        // Check if filePath is locateable
-        if (file.good())
+        FilePointer file = OpenFile(filePath, "wb");
+        if (!file)
         {
-            std::stringstream stringBuffer;
-            stringBuffer << file.rdbuf();
-            FromJsonFormat(stringBuffer, rttrObject);
-            return;
+            return ReportError(ErrorCode::FileNotWritable, filePath.u8string());
         }
 
-        std::cerr << "FilePath provided is incorrect!" << std::endl;
-        // Should not reach here
-        throw 0;
+        // Taken before the events, both lock the registry
+        const std::vector<TraceEntry> typeStats = GetTraceTypeStats();
+        const std::vector<TraceEntry> propertyStats = GetTracePropertyStats();
+        const size_t droppedEvents = GetTraceDroppedEvents();
+
+        char writeBuffer[WRITE_BUFFER_SIZE];
+        FileWriteStream stream{ file.get(), writeBuffer, sizeof(writeBuffer) };
+        TraceWriter writer{ stream };
+        writer.StartObject();
+        writer.Key("displayTimeUnit");
+        writer.String("ns");
+        WriteTraceEvents(writer);
+        WriteTraceStats(writer, "typeStats", typeStats);
+        WriteTraceStats(writer, "propertyStats", propertyStats);
+        writer.Key("droppedEvents");
+        writer.Uint64(droppedEvents);
+        writer.EndObject();
+        stream.Flush();
+        return std::ferror(file.get()) == 0 ? SerializationResult{} : ReportError(ErrorCode::FileWriteFailed, filePath.u8string());
     }
 
     // *********************************************************
@@ -1097,8 +3797,8 @@ namespace JSON
         if constexpr (TYPETRAITS::are_same<Type, std::string>::value || TYPETRAITS::are_same<Type, const char*>::value)
             return value.GetString();
 
-        std::cerr << "Unable to return a type" << std::endl;
-        throw 0;
+        ReportDiagnostic(ErrorCode::UnsupportedType, "Unable to return a type");
+        return Type{};
     }
 
     template <typename Type>
@@ -0,0 +1,771 @@
+/******************************************************************************/
+/*!
+\file       SerializationPlan.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _SERIALIZATION_PLAN_HPP_
+#define _SERIALIZATION_PLAN_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "rapidjson/document.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "rttr/type.h"
+#include "rttr/instance.h"
+
+/*  A TypePlan is everything the Writer/Reader needs to know about a reflected class, worked out once per rttr::type
+    instead of once per object.
+
+    Without it, every object written asks RTTR for its property list, does a string keyed get_metadata("NO_SERIALIZE")
+    per property and converts every property name into a std::string for the key.
+
+    The Reader walks the JSON members once and finds the property of each member through TypePlan::FindProperty,
+    instead of calling FindMember (a linear scan) for every reflected property.
+
+    Use GetTypePlan(type) to get the cached plan, it is built the first time a type is seen.
+ */
+
+namespace Binary
+{
+    class Encoder;
+}
+
+namespace JSON
+{
+    using namespace rttr;
+
+    class OutputStream;
+
+    // What has to be done with the value of a property, decided once from the property type
+    enum class PropertyKind
+    {
+        Atomic,         // Arithmetic types, std::string
+        Enumeration,    // Written as the enum name
+        Sequential,     // vector, list, array...
+        Associative,    // map, set...
+        Object          // Class/struct, written recursively
+    };
+
+    // Puts what was registered since into the plans that are already built, defined at the end
+    inline void RefreshTypePlans();
+
+    // Dense id of every atomic type the Writer/Reader support, used as the index into their dispatch tables
+    enum class AtomicType
+    {
+        None,           // Not an atomic type
+        Bool,
+        Char,
+        Int8,
+        Int16,
+        Int32,
+        Int64,
+        Uint8,
+        Uint16,
+        Uint32,
+        Uint64,
+        Float,
+        Double,
+        String,
+        CString,
+        Enumeration,
+        Count
+    };
+
+    // Compare chain, only run when a plan is built or once per container, never once per value
+    inline AtomicType GetAtomicType(const type& valueType)
+    {
+        if (valueType == type::get<bool>())
+            return AtomicType::Bool;
+        if (valueType == type::get<char>())
+            return AtomicType::Char;
+        if (valueType == type::get<int8_t>())
+            return AtomicType::Int8;
+        if (valueType == type::get<int16_t>())
+            return AtomicType::Int16;
+        if (valueType == type::get<int32_t>())
+            return AtomicType::Int32;
+        if (valueType == type::get<int64_t>())
+            return AtomicType::Int64;
+        if (valueType == type::get<uint8_t>())
+            return AtomicType::Uint8;
+        if (valueType == type::get<uint16_t>())
+            return AtomicType::Uint16;
+        if (valueType == type::get<uint32_t>())
+            return AtomicType::Uint32;
+        if (valueType == type::get<uint64_t>())
+            return AtomicType::Uint64;
+        if (valueType == type::get<float>())
+            return AtomicType::Float;
+        if (valueType == type::get<double>())
+            return AtomicType::Double;
+        if (valueType == type::get<std::string>())
+            return AtomicType::String;
+        if (valueType == type::get<const char*>())
+            return AtomicType::CString;
+        if (valueType.is_enumeration())
+            return AtomicType::Enumeration;
+        return AtomicType::None;
+    }
+
+    // *********************************************************
+    // *Contiguous arithmetic containers (std::vector<float>, std::array<int, N>...)
+    // *The Writer/Reader go over their elements as raw memory in a tight loop instead of one variant per element
+    // *std::vector of every arithmetic type in AtomicType (except bool/char) is known out of the box
+    // *Anything else with data()/size() (std::array<float, 3>...) has to be added with RegisterContiguousContainer before it is serialized
+    // *********************************************************
+    struct ContiguousContainer
+    {
+        AtomicType elementType;
+        size_t elementSize;
+        // Elements of the container held by value (the container itself or a std::reference_wrapper to it), false if it holds something else
+        bool (*view)(const variant& value, const void*& data, size_t& count);
+        // Resizes the container held by value to count and returns its elements, a fixed size container keeps its size
+        bool (*resize)(variant& value, size_t count, void*& data, size_t& resultCount);
+    };
+
+    template <typename Container, typename = void>
+    struct is_resizable : std::false_type {};
+
+    template <typename Container>
+    struct is_resizable<Container, std::void_t<decltype(std::declval<Container&>().resize(size_t{}))>> : std::true_type {};
+
+    template <typename Container>
+    const Container* GetContiguousContainer(const variant& value)
+    {
+        const type valueType = value.get_type();
+        if (valueType == type::get<Container>())
+            return &value.get_value<Container>();
+        if (valueType == type::get<std::reference_wrapper<Container>>())
+            return &value.get_value<std::reference_wrapper<Container>>().get();
+        if (valueType == type::get<std::reference_wrapper<const Container>>())
+            return &value.get_value<std::reference_wrapper<const Container>>().get();
+        return nullptr;
+    }
+
+    template <typename Container>
+    Container* GetMutableContiguousContainer(variant& value)
+    {
+        const type valueType = value.get_type();
+        if (valueType == type::get<Container>())
+            return &value.get_value<Container>();
+        if (valueType == type::get<std::reference_wrapper<Container>>())
+            return &value.get_value<std::reference_wrapper<Container>>().get();
+        return nullptr;
+    }
+
+    template <typename Container>
+    ContiguousContainer MakeContiguousContainer()
+    {
+        using Element = typename Container::value_type;
+        static_assert(std::is_arithmetic_v<Element> && !std::is_same_v<Element, bool> && !std::is_same_v<Element, char>,
+            "Only containers of numbers can be read/written as raw memory");
+
+        const auto view = [](const variant& value, const void*& data, size_t& count)
+        {
+            const Container* container = GetContiguousContainer<Container>(value);
+            if (container == nullptr)
+            {
+                return false;
+            }
+            data = container->data();
+            count = container->size();
+            return true;
+        };
+
+        const auto resize = [](variant& value, size_t count, void*& data, size_t& resultCount)
+        {
+            Container* container = GetMutableContiguousContainer<Container>(value);
+            if (container == nullptr)
+            {
+                return false;
+            }
+            if constexpr (is_resizable<Container>::value)
+            {
+                container->resize(count);
+            }
+            data = container->data();
+            resultCount = container->size();
+            return true;
+        };
+
+        return ContiguousContainer{ GetAtomicType(type::get<Element>()), sizeof(Element), view, resize };
+    }
+
+    inline std::unordered_map<type, ContiguousContainer>& GetContiguousContainers()
+    {
+        static std::unordered_map<type, ContiguousContainer> containers
+        {
+            { type::get<std::vector<int8_t>>(),   MakeContiguousContainer<std::vector<int8_t>>() },
+            { type::get<std::vector<int16_t>>(),  MakeContiguousContainer<std::vector<int16_t>>() },
+            { type::get<std::vector<int32_t>>(),  MakeContiguousContainer<std::vector<int32_t>>() },
+            { type::get<std::vector<int64_t>>(),  MakeContiguousContainer<std::vector<int64_t>>() },
+            { type::get<std::vector<uint8_t>>(),  MakeContiguousContainer<std::vector<uint8_t>>() },
+            { type::get<std::vector<uint16_t>>(), MakeContiguousContainer<std::vector<uint16_t>>() },
+            { type::get<std::vector<uint32_t>>(), MakeContiguousContainer<std::vector<uint32_t>>() },
+            { type::get<std::vector<uint64_t>>(), MakeContiguousContainer<std::vector<uint64_t>>() },
+            { type::get<std::vector<float>>(),    MakeContiguousContainer<std::vector<float>>() },
+            { type::get<std::vector<double>>(),   MakeContiguousContainer<std::vector<double>>() }
+        };
+        return containers;
+    }
+
+    // e.g. RegisterContiguousContainer<std::array<float, 3>>(), plans already built for types holding Container pick it up
+    // Not thread safe, register everything at start up before any threads serialize
+    template <typename Container>
+    void RegisterContiguousContainer()
+    {
+        GetContiguousContainers().insert_or_assign(type::get<Container>(), MakeContiguousContainer<Container>());
+        RefreshTypePlans();
+    }
+
+    // nullptr if containerType is not a registered contiguous container
+    inline const ContiguousContainer* FindContiguousContainer(const type& containerType)
+    {
+        const std::unordered_map<type, ContiguousContainer>& containers = GetContiguousContainers();
+        auto found = containers.find(containerType);
+        return found != containers.end() ? &found->second : nullptr;
+    }
+
+    // *********************************************************
+    // *Read/write functions generated from a compile time member list (MemberList.hpp), registered with RegisterMemberList
+    // *The Writer/Reader/SaxReader hand objects of the type to these instead of going property by property through RTTR
+    // *Only the output handlers the library itself uses have a write function, any other handler goes through RTTR
+    // *********************************************************
+    struct MemberListSerializer
+    {
+        static constexpr uint32_t NO_MEMBER = UINT32_MAX;
+
+        // TypePlan::properties index of every member, what the binary format writes as the property id
+        std::vector<uint32_t> propertyIds;
+        // Member index of every TypePlan::properties index, NO_MEMBER for the ones that are not serialized
+        std::vector<uint32_t> propertyMembers;
+
+        // The object inside object, nullptr if it does not hold the type
+        void* (*address)(const instance& object);
+        void (*writePretty)(rapidjson::PrettyWriter<OutputStream>& handler, const void* object);
+        void (*writeCompact)(rapidjson::Writer<OutputStream>& handler, const void* object);
+        void (*writeBinary)(Binary::Encoder& handler, const void* object);
+        // Whole JSON object, members that are not in the list are skipped
+        void (*read)(void* object, const rapidjson::Value& jsonObject);
+        // One scalar member, used by the SaxReader as the values arrive
+        void (*readMember)(void* object, uint32_t member, const rapidjson::Value& jsonValue);
+        // Emplaces the member into result if it is an object with a member list of its own
+        void (*memberObject)(void* object, uint32_t member, std::optional<instance>& result);
+    };
+
+    inline std::unordered_map<type, MemberListSerializer>& GetMemberLists()
+    {
+        static std::unordered_map<type, MemberListSerializer> memberLists;
+        return memberLists;
+    }
+
+    // nullptr if objectType has no registered member list
+    inline const MemberListSerializer* FindMemberList(const type& objectType)
+    {
+        const std::unordered_map<type, MemberListSerializer>& memberLists = GetMemberLists();
+        auto found = memberLists.find(objectType);
+        return found != memberLists.end() ? &found->second : nullptr;
+    }
+
+    // *********************************************************
+    // *Pointers to objects that several owners share (std::shared_ptr<T>, T*), only the object graph functions (ObjectGraph.hpp) use them
+    // *There every object pointed to is written once into a reference table and the pointers become ids into it
+    // *Every pointer type of a graph has to be added with RegisterReference before it is saved or loaded, the normal save ignores them
+    // *********************************************************
+    struct ReferenceType
+    {
+        // Type of the object pointed to, it is saved and loaded as this type
+        type objectType;
+        // Object the pointer held by value (the pointer itself or a std::reference_wrapper to it) points to, nullptr for a null pointer
+        const void* (*address)(const variant& value);
+        // Pointer to object as the registered pointer type, a null pointer for nullptr
+        variant (*make)(const std::shared_ptr<void>& object);
+        // One default constructed objectType, the single allocation of a loaded object
+        std::shared_ptr<void> (*create)();
+        instance (*object)(void* address);
+    };
+
+    inline std::unordered_map<type, ReferenceType>& GetReferenceTypes()
+    {
+        static std::unordered_map<type, ReferenceType> referenceTypes;
+        return referenceTypes;
+    }
+
+    // nullptr if pointerType is not a registered reference
+    inline const ReferenceType* FindReferenceType(const type& pointerType)
+    {
+        const std::unordered_map<type, ReferenceType>& referenceTypes = GetReferenceTypes();
+        auto found = referenceTypes.find(pointerType);
+        return found != referenceTypes.end() ? &found->second : nullptr;
+    }
+
+    // nullptr if no registered reference points to objectType
+    inline const ReferenceType* FindReferencedObject(const type& objectType)
+    {
+        for (const auto& referenceType : GetReferenceTypes())
+        {
+            if (referenceType.second.objectType == objectType)
+            {
+                return &referenceType.second;
+            }
+        }
+        return nullptr;
+    }
+
+    // e.g. RegisterReference<std::shared_ptr<material>>() or RegisterReference<material*>(), material has to be registered with RTTR
+    // A raw pointer does not own what it points to, after a load it points to the object the shared_ptrs of the graph own
+    // Not thread safe, register everything at start up before any threads serialize
+    template <typename Pointer>
+    void RegisterReference()
+    {
+        using Object = typename std::pointer_traits<Pointer>::element_type;
+        static_assert(std::is_same_v<Pointer, Object*> || std::is_same_v<Pointer, std::shared_ptr<Object>>, "Only std::shared_ptr<T> and T* can be references");
+        static_assert(std::is_default_constructible_v<Object>, "Loading a reference default constructs the object");
+
+        const auto address = [](const variant& value) -> const void*
+        {
+            const type valueType = value.get_type();
+            const Pointer* pointer = nullptr;
+            if (valueType == type::get<Pointer>())
+                pointer = &value.get_value<Pointer>();
+            else if (valueType == type::get<std::reference_wrapper<Pointer>>())
+                pointer = &value.get_value<std::reference_wrapper<Pointer>>().get();
+            else if (valueType == type::get<std::reference_wrapper<const Pointer>>())
+                pointer = &value.get_value<std::reference_wrapper<const Pointer>>().get();
+            if (pointer == nullptr)
+                return nullptr;
+            if constexpr (std::is_pointer_v<Pointer>)
+                return *pointer;
+            else
+                return pointer->get();
+        };
+
+        const auto make = [](const std::shared_ptr<void>& object) -> variant
+        {
+            if constexpr (std::is_pointer_v<Pointer>)
+                return variant(static_cast<Object*>(object.get()));
+            else
+                return variant(std::static_pointer_cast<Object>(object));
+        };
+
+        const auto create = []() -> std::shared_ptr<void>
+        {
+            return std::make_shared<Object>();
+        };
+
+        const auto object = [](void* objectAddress) -> instance
+        {
+            return instance(*static_cast<Object*>(objectAddress));
+        };
+
+        GetReferenceTypes().insert_or_assign(type::get<Pointer>(), ReferenceType{ type::get<Object>(), address, make, create, object });
+        RefreshTypePlans();
+    }
+
+    // *********************************************************
+    // *Members that a property can be reached through in place, property::get_value only ever returns a copy of the member
+    // *The JSON Patch walk (JsonPatch.hpp, the partial load goes through it too) uses these on the way down a path,
+    // *so /circles/3/radius does not copy circles out of the object and set it back
+    // *Add them with RegisterPropertyReference, properties without one are still copied
+    // *********************************************************
+    // std::reference_wrapper to the member inside object, an invalid variant if object does not hold the declaring class
+    using PropertyReference = variant (*)(const instance& object);
+
+    inline std::vector<std::pair<property, PropertyReference>>& GetPropertyReferences()
+    {
+        static std::vector<std::pair<property, PropertyReference>> propertyReferences;
+        return propertyReferences;
+    }
+
+    // nullptr if prop has no registered reference
+    inline PropertyReference FindPropertyReference(const property& prop)
+    {
+        for (const auto& propertyReference : GetPropertyReferences())
+        {
+            if (propertyReference.first == prop)
+            {
+                return propertyReference.second;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename MemberPointer>
+    struct member_pointer_traits {};
+
+    template <typename Class, typename Type>
+    struct member_pointer_traits<Type Class::*>
+    {
+        using class_type = Class;
+        using value_type = Type;
+    };
+
+    // e.g. RegisterPropertyReference<&scene::circles>("circles"), name is the name the member is registered under with RTTR
+    // False if the class has no property called name holding the member type (bind_as_ptr properties do not need one)
+    // Not thread safe, register everything at start up before any threads serialize
+    template <auto Member>
+    bool RegisterPropertyReference(string_view name)
+    {
+        using Class = typename member_pointer_traits<decltype(Member)>::class_type;
+        using Type = typename member_pointer_traits<decltype(Member)>::value_type;
+
+        const property prop = type::get<Class>().get_property(name);
+        if (!prop.is_valid() || prop.get_type() != type::get<Type>())
+        {
+            return false;
+        }
+
+        const auto reference = [](const instance& object) -> variant
+        {
+            Class* owner = object.try_convert<Class>();
+            return owner != nullptr ? variant(std::ref(owner->*Member)) : variant();
+        };
+
+        std::vector<std::pair<property, PropertyReference>>& propertyReferences = GetPropertyReferences();
+        propertyReferences.erase(std::remove_if(propertyReferences.begin(), propertyReferences.end(),
+            [&prop](const std::pair<property, PropertyReference>& propertyReference) { return propertyReference.first == prop; }),
+            propertyReferences.end());
+        propertyReferences.emplace_back(prop, reference);
+        RefreshTypePlans();
+        return true;
+    }
+
+    struct PropertyPlan
+    {
+        property prop;
+        // Property type, with the wrapper (e.g. std::reference_wrapper) removed
+        type valueType;
+        bool isWrapper;
+        PropertyKind kind;
+        // Index into the atomic dispatch tables, None for containers/objects
+        AtomicType atomicType;
+        // Raw memory access for contiguous arithmetic containers, nullptr otherwise
+        const ContiguousContainer* contiguous;
+        // Shared object pointer, nullptr otherwise
+        const ReferenceType* reference;
+        // The member inside its object (RegisterPropertyReference), nullptr if prop.get_value's copy is all there is
+        PropertyReference inPlace;
+        // Marked with metadata("NO_SERIALIZE", true), the writer skips it, the reader still accepts it
+        bool noSerialize;
+        std::string name;
+        // Name already quoted and escaped as a JSON string ("name"), written as is by the writer
+        std::string encodedKey;
+    };
+
+    // *********************************************************
+    // *Perfect hash from a property name to its index in TypePlan::properties (hash and displace)
+    // *Names are put into buckets, every bucket gets a displacement that sends all of its names into free slots
+    // *A lookup is then one hash, one displacement read and one string compare, no matter how many properties there are
+    // *********************************************************
+    class PropertyLookup
+    {
+    public:
+        static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+        // names[i] is the name of TypePlan::properties[i]
+        void Build(const std::vector<std::string_view>& names)
+        {
+            m_Slots.clear();
+            m_Displacements.clear();
+
+            // A name that is already in (a derived class hiding a base property) keeps the first index
+            std::vector<std::pair<uint64_t, uint32_t>> entries;
+            for (uint32_t i = 0; i < names.size(); ++i)
+            {
+                const uint64_t hash = Hash(names[i].data(), names[i].size());
+                const auto sameHash = [hash](const std::pair<uint64_t, uint32_t>& entry) { return entry.first == hash; };
+                if (std::find_if(entries.begin(), entries.end(), sameHash) == entries.end())
+                {
+                    entries.emplace_back(hash, i);
+                }
+            }
+
+            const size_t count = entries.size();
+            if (count == 0)
+            {
+                return;
+            }
+
+            // Around 2 names per bucket, slots a bit bigger than count so a displacement is found quickly
+            const size_t bucketCount = NextPowerOfTwo((count + 1) / 2);
+            size_t slotCount = NextPowerOfTwo(count + count / 4 + 1);
+
+            while (!TryBuild(entries, bucketCount, slotCount))
+            {
+                // Practically never happens, more slots makes it easier to place every bucket
+                slotCount *= 2;
+            }
+        }
+
+        // Index into TypePlan::properties, the caller still has to compare the name as any string hashes to some slot
+        uint32_t Find(const char* name, size_t length) const
+        {
+            if (m_Slots.empty())
+            {
+                return NOT_FOUND;
+            }
+
+            const uint64_t hash = Hash(name, length);
+            const uint32_t displacement = m_Displacements[hash & (m_Displacements.size() - 1)];
+            return m_Slots[Slot(hash, displacement)];
+        }
+
+    private:
+        static uint64_t Hash(const char* name, size_t length)
+        {
+            // FNV-1a
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < length; ++i)
+            {
+                hash ^= static_cast<unsigned char>(name[i]);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        // splitmix64 finalizer, spreads the displacement over all slot bits
+        size_t Slot(uint64_t hash, uint32_t displacement) const
+        {
+            uint64_t mixed = hash + (static_cast<uint64_t>(displacement) + 1) * 0x9E3779B97F4A7C15ull;
+            mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+            mixed ^= mixed >> 31;
+            return static_cast<size_t>(mixed & (m_Slots.size() - 1));
+        }
+
+        static size_t NextPowerOfTwo(size_t value)
+        {
+            size_t power = 1;
+            while (power < value)
+            {
+                power *= 2;
+            }
+            return power;
+        }
+
+        bool TryBuild(const std::vector<std::pair<uint64_t, uint32_t>>& entries, size_t bucketCount, size_t slotCount)
+        {
+            constexpr uint32_t MAX_DISPLACEMENT = 1u << 16;
+
+            m_Slots.assign(slotCount, NOT_FOUND);
+            m_Displacements.assign(bucketCount, 0);
+
+            // Entry positions per bucket
+            std::vector<std::vector<size_t>> buckets(bucketCount);
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                buckets[entries[i].first & (bucketCount - 1)].push_back(i);
+            }
+
+            // Biggest buckets first, they are the hardest to place
+            std::vector<size_t> order(bucketCount);
+            for (size_t i = 0; i < bucketCount; ++i)
+            {
+                order[i] = i;
+            }
+            std::sort(order.begin(), order.end(), [&buckets](size_t lhs, size_t rhs)
+                {
+                    return buckets[lhs].size() > buckets[rhs].size();
+                });
+
+            std::vector<size_t> placed;
+            for (const size_t bucket : order)
+            {
+                if (buckets[bucket].empty())
+                {
+                    break;
+                }
+
+                bool found = false;
+                for (uint32_t displacement = 0; displacement < MAX_DISPLACEMENT && !found; ++displacement)
+                {
+                    placed.clear();
+                    found = true;
+                    for (const size_t entry : buckets[bucket])
+                    {
+                        const size_t slot = Slot(entries[entry].first, displacement);
+                        if (m_Slots[slot] != NOT_FOUND || std::find(placed.begin(), placed.end(), slot) != placed.end())
+                        {
+                            found = false;
+                            break;
+                        }
+                        placed.push_back(slot);
+                    }
+
+                    if (found)
+                    {
+                        for (size_t i = 0; i < placed.size(); ++i)
+                        {
+                            m_Slots[placed[i]] = entries[buckets[bucket][i]].second;
+                        }
+                        m_Displacements[bucket] = displacement;
+                    }
+                }
+
+                if (!found)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::vector<uint32_t> m_Slots;
+        std::vector<uint32_t> m_Displacements;
+    };
+
+    struct TypePlan
+    {
+        // Same order as type::get_properties(), base class properties first
+        std::vector<PropertyPlan> properties;
+        PropertyLookup lookup;
+        // Generated functions for the whole object, nullptr if it goes through RTTR
+        const MemberListSerializer* memberList = nullptr;
+
+        // Property called name, nullptr if this type has no such property
+        const PropertyPlan* FindProperty(const char* name, size_t length) const
+        {
+            const uint32_t index = lookup.Find(name, length);
+            if (index == PropertyLookup::NOT_FOUND)
+            {
+                return nullptr;
+            }
+
+            const PropertyPlan& propertyPlan = properties[index];
+            if (propertyPlan.name.size() != length || std::memcmp(propertyPlan.name.data(), name, length) != 0)
+            {
+                return nullptr;
+            }
+            return &propertyPlan;
+        }
+    };
+
+    inline PropertyKind GetPropertyKind(const type& propertyType)
+    {
+        const type valueType = propertyType.is_wrapper() ? propertyType.get_wrapped_type() : propertyType;
+
+        if (valueType.is_arithmetic() || valueType == type::get<std::string>() || valueType == type::get<const char*>())
+            return PropertyKind::Atomic;
+        if (valueType.is_enumeration())
+            return PropertyKind::Enumeration;
+        if (propertyType.is_sequential_container())
+            return PropertyKind::Sequential;
+        if (propertyType.is_associative_container())
+            return PropertyKind::Associative;
+        return PropertyKind::Object;
+    }
+
+    // Quotes and escapes name exactly the way rapidjson::Writer::Key would
+    inline std::string EncodeKey(string_view name)
+    {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.String(name.data(), static_cast<rapidjson::SizeType>(name.size()));
+        return std::string(buffer.GetString(), buffer.GetSize());
+    }
+
+    inline TypePlan BuildTypePlan(const type& objectType)
+    {
+        TypePlan plan;
+
+        for (const property& prop : objectType.get_properties())
+        {
+            const type propertyType = prop.get_type();
+            const type valueType = propertyType.is_wrapper() ? propertyType.get_wrapped_type() : propertyType;
+            const string_view name = prop.get_name();
+
+            plan.properties.push_back(PropertyPlan{
+                prop,
+                valueType,
+                propertyType.is_wrapper(),
+                GetPropertyKind(propertyType),
+                GetAtomicType(valueType),
+                FindContiguousContainer(valueType),
+                FindReferenceType(propertyType),
+                FindPropertyReference(prop),
+                static_cast<bool>(prop.get_metadata("NO_SERIALIZE")),
+                std::string(name.data(), name.size()),
+                EncodeKey(name) });
+        }
+
+        std::vector<std::string_view> names;
+        names.reserve(plan.properties.size());
+        for (const PropertyPlan& propertyPlan : plan.properties)
+        {
+            names.emplace_back(propertyPlan.name);
+        }
+        plan.lookup.Build(names);
+        plan.memberList = FindMemberList(objectType);
+        return plan;
+    }
+
+    struct TypePlanCache
+    {
+        // unordered_map never moves its values, so references to the plans stay valid
+        std::unordered_map<type, TypePlan> plans;
+        std::shared_mutex mutex;
+    };
+
+    inline TypePlanCache& GetTypePlanCache()
+    {
+        static TypePlanCache cache;
+        return cache;
+    }
+
+    // Cached plan of objectType, built on first use
+    // Safe to call from several threads, lookups of plans that are already built only take a shared lock
+    inline const TypePlan& GetTypePlan(const type& objectType)
+    {
+        TypePlanCache& cache = GetTypePlanCache();
+        {
+            std::shared_lock<std::shared_mutex> lock{ cache.mutex };
+            auto found = cache.plans.find(objectType);
+            if (found != cache.plans.end())
+            {
+                return found->second;
+            }
+        }
+
+        // Built outside of the lock, another thread may have built it meanwhile and then its plan is kept
+        TypePlan plan = BuildTypePlan(objectType);
+        std::unique_lock<std::shared_mutex> lock{ cache.mutex };
+        return cache.plans.emplace(objectType, std::move(plan)).first->second;
+    }
+
+    // Every Register* function calls this, a plan built before a registration would otherwise never see it
+    inline void RefreshTypePlans()
+    {
+        TypePlanCache& cache = GetTypePlanCache();
+        std::unique_lock<std::shared_mutex> lock{ cache.mutex };
+        for (auto& [objectType, plan] : cache.plans)
+        {
+            plan.memberList = FindMemberList(objectType);
+            for (PropertyPlan& propertyPlan : plan.properties)
+            {
+                propertyPlan.contiguous = FindContiguousContainer(propertyPlan.valueType);
+                propertyPlan.reference = FindReferenceType(propertyPlan.prop.get_type());
+                propertyPlan.inPlace = FindPropertyReference(propertyPlan.prop);
+            }
+        }
+    }
+}
+
+#endif
@@ -16,8 +16,10 @@
 #else   
 #include "Logger.h"
 #include <cassert>
+#include <iostream>
+#include <sstream>
 
-/*If Assert fail,*/
+/*If Assert fail, the message goes through the process wide logger and is flushed before assert stops the program*/
 #define SPACEASSERT(condition, logMessage)\
             {\
                 if (!(condition))\
@@ -25,8 +27,8 @@
                     std::stringstream loggedMessage;\
                     std::cout << logMessage << std::endl;\
                     loggedMessage << "Assert Crashed: " << #logMessage << " at " << __FILE__ << " (" << __LINE__ << ")" ; \
-                    Logger log("log\\Assertion.log");\
-                    log.logError(loggedMessage.str(), ErrorType::ERROR);\
+                    ::Logger::getAssertionLogger().logError(loggedMessage.str(), ::Logger::ErrorType::ERROR);\
+                    ::Logger::getAssertionLogger().flush();\
                     assert(condition);\
                 }\
             }
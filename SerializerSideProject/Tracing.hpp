@@ -0,0 +1,377 @@
+/******************************************************************************/
+/*!
+\file       Tracing.hpp
+\author     Darren Lin (100% code contribution)
+\copyright  Copyright (C) 2021 DigiPen Institute of Technology. Reproduction
+            or disclosure of this file or its contents without the prior
+            written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+#ifndef _TRACING_HPP_
+#define _TRACING_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SerializationPlan.hpp"
+
+/*  Opt-in tracing of the Reader and Writer, define JSONTRACE (before including Serialization.hpp or in the project settings)
+    to compile it in. Without it every JSON_TRACE_* macro is ((void)0) and nothing is recorded.
+
+    Every object, variant, container and property the Writer writes or the Reader reads is one scope. Each thread keeps
+    the count, the inclusive time and the bytes per rttr::type and per property, and the scopes themselves as Chrome
+    trace events (TRACE_EVENT_LIMIT per thread, the counts go on after that).
+    Bytes written are what went into a JSON::OutputStream (JSON and binary). Bytes read are counted by the load scope
+    around the parse and the read of the in memory loads, walking an already parsed Document reads no input.
+
+    JSON::WriteChromeTrace (Serialization.hpp) writes everything recorded as a file chrome://tracing and ui.perfetto.dev open.
+    The record of a thread that exits is kept for the results and taken over by the next thread that starts tracing,
+    so the batch functions starting threads per call do not add records. ResetTrace frees the ones no thread is using.
+    Reading the results and ResetTrace must not run while traced saves or loads are still running.
+ */
+
+#ifdef JSONTRACE
+#define JSON_TRACE_CONCAT_IMPL(left, right) left##right
+#define JSON_TRACE_CONCAT(left, right) JSON_TRACE_CONCAT_IMPL(left, right)
+
+// Scope for an object, variant or container of rttrType until the end of the block
+#define JSON_TRACE_TYPE(operation, rttrType) \
+    const JSON::TraceScope JSON_TRACE_CONCAT(traceScope, __LINE__){ JSON::TraceOperation::operation, rttrType }
+
+// Scope for the property of propertyPlan until the end of the block
+#define JSON_TRACE_PROPERTY(operation, propertyPlan) \
+    const JSON::TraceScope JSON_TRACE_CONCAT(traceScope, __LINE__){ JSON::TraceOperation::operation, propertyPlan }
+
+// Load of byteCount bytes of input into rttrType (parse and read) until the end of the block
+#define JSON_TRACE_LOAD(rttrType, byteCount) \
+    const JSON::TraceScope JSON_TRACE_CONCAT(traceScope, __LINE__){ JSON::TraceOperation::Load, rttrType, byteCount }
+
+// byteCount bytes written by this thread
+#define JSON_TRACE_BYTES(byteCount) (JSON::GetTraceThread().bytesWritten += (byteCount))
+
+#else
+#define JSON_TRACE_TYPE(operation, rttrType) ((void)0)
+#define JSON_TRACE_PROPERTY(operation, propertyPlan) ((void)0)
+#define JSON_TRACE_LOAD(rttrType, byteCount) ((void)0)
+#define JSON_TRACE_BYTES(byteCount) ((void)0)
+#endif
+
+namespace JSON
+{
+    enum class TraceOperation : uint8_t
+    {
+        Write = 0,
+        Read,
+        Load,
+        Count
+    };
+
+    inline const char* GetTraceOperationName(TraceOperation operation)
+    {
+        switch (operation)
+        {
+        case TraceOperation::Write: return "write";
+        case TraceOperation::Read:  return "read";
+        case TraceOperation::Load:  return "load";
+        default:                    return "unknown";
+        }
+    }
+
+    struct TraceStats
+    {
+        uint64_t count = 0;
+        // Inclusive, a nested object is also part of the time of the property and the object it is in
+        uint64_t nanoseconds = 0;
+        uint64_t bytes = 0;
+    };
+
+    // Stats of one type or property over every thread
+    struct TraceEntry
+    {
+        TraceOperation operation;
+        // Type name, or declaring type::property
+        std::string name;
+        TraceStats stats;
+    };
+
+    // Events kept per thread, the stats are kept for every scope regardless
+    constexpr size_t TRACE_EVENT_LIMIT = 1 << 18;
+
+    // *********************************************************
+    // *Everything one thread recorded, only that thread writes to it
+    // *********************************************************
+    struct TraceThread
+    {
+        struct Event
+        {
+            // Nanoseconds since the first traced thread started
+            int64_t start;
+            int64_t duration;
+            uint64_t bytes;
+            type valueType;
+            // nullptr for an object, variant or container scope
+            const PropertyPlan* property;
+            TraceOperation operation;
+        };
+
+        TraceThread(uint32_t index, std::chrono::steady_clock::time_point epoch) : threadIndex{ index }, startTime{ epoch }
+        {
+        }
+
+        int64_t Now() const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+        }
+
+        void Record(TraceOperation operation, const type& valueType, const PropertyPlan* property, int64_t start, int64_t end, uint64_t bytes)
+        {
+            const size_t operationIndex = static_cast<size_t>(operation);
+            TraceStats& stats = property != nullptr ? propertyStats[operationIndex][property] : typeStats[operationIndex][valueType];
+            ++stats.count;
+            stats.nanoseconds += static_cast<uint64_t>(end - start);
+            stats.bytes += bytes;
+
+            if (events.size() < TRACE_EVENT_LIMIT)
+            {
+                events.push_back(Event{ start, end - start, bytes, valueType, property, operation });
+            }
+            else
+            {
+                ++droppedEvents;
+            }
+        }
+
+        void Clear()
+        {
+            events.clear();
+            droppedEvents = 0;
+            for (size_t i = 0; i < static_cast<size_t>(TraceOperation::Count); ++i)
+            {
+                typeStats[i].clear();
+                propertyStats[i].clear();
+            }
+        }
+
+        const uint32_t threadIndex;
+        const std::chrono::steady_clock::time_point startTime;
+        // The thread recording into it has exited, only read and written under the registry mutex
+        bool isExited = false;
+        // Every byte this thread put into an OutputStream, scopes take the difference
+        uint64_t bytesWritten = 0;
+        std::vector<Event> events;
+        size_t droppedEvents = 0;
+        std::unordered_map<type, TraceStats> typeStats[static_cast<size_t>(TraceOperation::Count)];
+        std::unordered_map<const PropertyPlan*, TraceStats> propertyStats[static_cast<size_t>(TraceOperation::Count)];
+    };
+
+    // Records of the threads that have traced anything, kept after they exit so the batch workers show up in the results
+    struct TraceRegistry
+    {
+        std::mutex mutex;
+        const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        std::vector<std::shared_ptr<TraceThread>> threads;
+        uint32_t nextThreadIndex = 0;
+    };
+
+    inline TraceRegistry& GetTraceRegistry()
+    {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    // *********************************************************
+    // *The record of one thread while it runs, the record of an exited thread is taken over before a new one is made
+    // *********************************************************
+    class TraceThreadSlot
+    {
+    public:
+        TraceThreadSlot()
+        {
+            TraceRegistry& registry = GetTraceRegistry();
+            std::lock_guard<std::mutex> lock{ registry.mutex };
+            for (const std::shared_ptr<TraceThread>& thread : registry.threads)
+            {
+                if (thread->isExited)
+                {
+                    thread->isExited = false;
+                    m_Thread = thread;
+                    return;
+                }
+            }
+            registry.threads.push_back(std::make_shared<TraceThread>(registry.nextThreadIndex++, registry.startTime));
+            m_Thread = registry.threads.back();
+        }
+
+        ~TraceThreadSlot()
+        {
+            TraceRegistry& registry = GetTraceRegistry();
+            std::lock_guard<std::mutex> lock{ registry.mutex };
+            m_Thread->isExited = true;
+        }
+
+        TraceThreadSlot(const TraceThreadSlot&) = delete;
+        TraceThreadSlot& operator=(const TraceThreadSlot&) = delete;
+
+        TraceThread& GetThread() const
+        {
+            return *m_Thread;
+        }
+
+    private:
+        std::shared_ptr<TraceThread> m_Thread;
+    };
+
+    inline TraceThread& GetTraceThread()
+    {
+        thread_local const TraceThreadSlot slot;
+        return slot.GetThread();
+    }
+
+    // *********************************************************
+    // *Times the block it is declared in, made by the JSON_TRACE_* macros
+    // *********************************************************
+    class TraceScope
+    {
+    public:
+        TraceScope(TraceOperation operation, const type& valueType, uint64_t bytes = 0) :
+            m_Thread{ GetTraceThread() }, m_ValueType{ valueType }, m_Property{ nullptr }, m_Operation{ operation },
+            m_Bytes{ bytes }, m_StartBytes{ m_Thread.bytesWritten }, m_Start{ m_Thread.Now() }
+        {
+        }
+
+        TraceScope(TraceOperation operation, const PropertyPlan& propertyPlan) :
+            m_Thread{ GetTraceThread() }, m_ValueType{ propertyPlan.valueType }, m_Property{ &propertyPlan }, m_Operation{ operation },
+            m_Bytes{ 0 }, m_StartBytes{ m_Thread.bytesWritten }, m_Start{ m_Thread.Now() }
+        {
+        }
+
+        ~TraceScope()
+        {
+            m_Thread.Record(m_Operation, m_ValueType, m_Property, m_Start, m_Thread.Now(), m_Bytes + m_Thread.bytesWritten - m_StartBytes);
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        TraceThread& m_Thread;
+        type m_ValueType;
+        const PropertyPlan* m_Property;
+        TraceOperation m_Operation;
+        uint64_t m_Bytes;
+        uint64_t m_StartBytes;
+        int64_t m_Start;
+    };
+
+    // *********************************************************
+    // *Trace Results
+    // *********************************************************
+    inline std::string GetTraceName(const type& valueType, const PropertyPlan* property)
+    {
+        if (property == nullptr)
+        {
+            return valueType.get_name().to_string();
+        }
+        return property->prop.get_declaring_type().get_name().to_string() + "::" + property->name;
+    }
+
+    // Sorted by time, the slowest first
+    inline std::vector<TraceEntry> SortTraceEntries(std::map<std::pair<TraceOperation, std::string>, TraceStats>& merged)
+    {
+        std::vector<TraceEntry> entries;
+        entries.reserve(merged.size());
+        for (auto& [key, stats] : merged)
+        {
+            entries.push_back(TraceEntry{ key.first, std::move(key.second), stats });
+        }
+        std::sort(entries.begin(), entries.end(), [](const TraceEntry& left, const TraceEntry& right)
+            {
+                return left.stats.nanoseconds > right.stats.nanoseconds;
+            });
+        return entries;
+    }
+
+    inline void MergeTraceStats(TraceStats& total, const TraceStats& stats)
+    {
+        total.count += stats.count;
+        total.nanoseconds += stats.nanoseconds;
+        total.bytes += stats.bytes;
+    }
+
+    // Per rttr::type, every thread merged
+    inline std::vector<TraceEntry> GetTraceTypeStats()
+    {
+        TraceRegistry& registry = GetTraceRegistry();
+        std::lock_guard<std::mutex> lock{ registry.mutex };
+        std::map<std::pair<TraceOperation, std::string>, TraceStats> merged;
+        for (const std::shared_ptr<TraceThread>& thread : registry.threads)
+        {
+            for (size_t operation = 0; operation < static_cast<size_t>(TraceOperation::Count); ++operation)
+            {
+                for (const auto& [valueType, stats] : thread->typeStats[operation])
+                {
+                    MergeTraceStats(merged[{ static_cast<TraceOperation>(operation), GetTraceName(valueType, nullptr) }], stats);
+                }
+            }
+        }
+        return SortTraceEntries(merged);
+    }
+
+    // Per property, the same property reached through different derived types is one entry
+    inline std::vector<TraceEntry> GetTracePropertyStats()
+    {
+        TraceRegistry& registry = GetTraceRegistry();
+        std::lock_guard<std::mutex> lock{ registry.mutex };
+        std::map<std::pair<TraceOperation, std::string>, TraceStats> merged;
+        for (const std::shared_ptr<TraceThread>& thread : registry.threads)
+        {
+            for (size_t operation = 0; operation < static_cast<size_t>(TraceOperation::Count); ++operation)
+            {
+                for (const auto& [property, stats] : thread->propertyStats[operation])
+                {
+                    MergeTraceStats(merged[{ static_cast<TraceOperation>(operation), GetTraceName(property->valueType, property) }], stats);
+                }
+            }
+        }
+        return SortTraceEntries(merged);
+    }
+
+    // Scopes past TRACE_EVENT_LIMIT that are only in the stats
+    inline size_t GetTraceDroppedEvents()
+    {
+        TraceRegistry& registry = GetTraceRegistry();
+        std::lock_guard<std::mutex> lock{ registry.mutex };
+        size_t dropped = 0;
+        for (const std::shared_ptr<TraceThread>& thread : registry.threads)
+        {
+            dropped += thread->droppedEvents;
+        }
+        return dropped;
+    }
+
+    // Clears what the running threads recorded and frees the records of the threads that have exited
+    inline void ResetTrace()
+    {
+        TraceRegistry& registry = GetTraceRegistry();
+        std::lock_guard<std::mutex> lock{ registry.mutex };
+        registry.threads.erase(std::remove_if(registry.threads.begin(), registry.threads.end(), [](const std::shared_ptr<TraceThread>& thread)
+            {
+                return thread->isExited;
+            }), registry.threads.end());
+
+        for (const std::shared_ptr<TraceThread>& thread : registry.threads)
+        {
+            thread->Clear();
+        }
+    }
+}
+
+#endif
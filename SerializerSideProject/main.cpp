@@ -1,4 +1,4 @@
-#include "Serialization.hpp"
+#include "MemberListSerializer.hpp"
 using namespace Reflect;
 
 // Property = variables
@@ -6,6 +6,14 @@ using namespace Reflect;
 
 int main()
 {
+    // The serializer prints nothing itself, the console sink shows its diagnostics
+    JSON::ConsoleDiagnosticSink console;
+    JSON::SetDiagnosticSink(&console);
+
+    // point2d and Vector3 skip the per property RTTR walk from here on
+    JSON::RegisterMemberList<point2d>();
+    JSON::RegisterMemberList<Vector3>();
+
     circle c_1("Circle #1");
     shape& my_shape = c_1;
 